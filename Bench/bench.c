@@ -0,0 +1,215 @@
+/**
+ ********************************************************
+ * @file    Bench/bench.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the benchmark firmware
+ *          which measures the cost of the SysTick and
+ *          PendSV handlers and the task wake latency
+ *          with synthetic yield, ping-pong and delay
+ *          workloads at several task counts. Results are
+ *          printed as CSV through semihosting, so the
+ *          benchmark runs under QEMU without a board.
+ ********************************************************
+ */
+
+#include "bench_hooks.h"
+#include "event_groups.h"
+#include "scb.h"
+#include "scheduler.h"
+#include "semihosting.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_PHASE_TICKS 200U // duration of every workload at every task count
+
+/**
+ * @brief An enumeration to define the synthetic
+ *        workloads run by the worker tasks
+ */
+enum bench_workload {
+    BENCH_YIELD,    /**< All workers yield to each other in a round robin fashion */
+    BENCH_PINGPONG, /**< A token is passed around the workers through an event group */
+    BENCH_DELAY,    /**< All workers delay for one tick at a time */
+    BENCH_WORKLOADS
+};
+
+static const char *const workload_names[BENCH_WORKLOADS] = {"yield", "pingpong", "delay"};
+static const uint8_t task_counts[] = {2, 4, 8, 16};
+
+volatile uint8_t bench_recording = 0;
+volatile uint8_t bench_use_cycle_counter = 0;
+volatile uint32_t bench_tick_entry = 0;
+volatile uint32_t bench_pendsv_entry = 0;
+BenchStat_Type bench_tick_isr;
+
+static BenchStat_Type switch_latency; // PendSV entry to the resumed task running again
+static BenchStat_Type wake_latency;   // event or tick that readies a task to the task running
+
+static volatile uint8_t workload = BENCH_YIELD;
+static volatile uint32_t phase_end = 0;
+static volatile uint32_t wake_time = 0;
+static uint8_t worker_count = 0;
+static uint8_t worker_index[MAX_TASKS]; // index of every worker task, by task id
+
+static EventGroup_Type start_event; // bit n starts worker n on the current workload
+static EventGroup_Type done_event;  // bit n is set by worker n when the workload is over
+static EventGroup_Type token_event; // bit n hands the ping-pong token to worker n
+
+/**
+ * @brief Check if the current workload phase is over.
+ * @param None
+ * @retval Non-zero once the phase has run for `BENCH_PHASE_TICKS` ticks.
+ */
+static int phase_over(void) {
+    return (int32_t)(g_tick_count - phase_end) >= 0;
+}
+
+/**
+ * @brief Yield workload: every worker yields as fast as it can and measures the time
+ *        from the PendSV handler entry to its own resumption.
+ * @param None
+ * @retval None
+ */
+static void run_yield(void) {
+    while (!phase_over()) {
+        task_yield();
+        bench_record(&switch_latency, bench_elapsed(bench_pendsv_entry, bench_now()));
+    }
+}
+
+/**
+ * @brief Ping-pong workload: a token is passed around all workers through an event
+ *        group, and every worker measures the time from the token being set to it
+ *        running. Once the phase is over every worker passes the token on once more,
+ *        so all workers leave the workload.
+ * @param self The index of the worker.
+ * @param count The number of workers taking part.
+ * @retval None
+ */
+static void run_pingpong(uint8_t self, uint8_t count) {
+    uint32_t next = 1U << ((self + 1) % count);
+    int over = 0;
+
+    while (!over) {
+        event_group_wait(&token_event, 1U << self, EVENT_CLEAR_ON_EXIT, WAIT_FOREVER);
+        bench_record(&wake_latency, bench_elapsed(wake_time, bench_now()));
+
+        over = phase_over();
+        wake_time = bench_now();
+        event_group_set(&token_event, next);
+    }
+}
+
+/**
+ * @brief Delay workload: every worker delays for one tick at a time and measures the
+ *        time from the SysTick handler entry to it running again.
+ * @param None
+ * @retval None
+ */
+static void run_delay(void) {
+    while (!phase_over()) {
+        task_delay(1);
+        bench_record(&wake_latency, bench_elapsed(bench_tick_entry, bench_now()));
+    }
+}
+
+/**
+ * @brief The worker task waits for the controller to start a workload, runs it until
+ *        the phase is over and reports back to the controller.
+ * @param None
+ * @retval None
+ */
+static void bench_worker(void) {
+    uint8_t self = worker_index[current_task];
+
+    while (1) {
+        event_group_wait(&start_event, 1U << self, EVENT_CLEAR_ON_EXIT, WAIT_FOREVER);
+
+        if (workload == BENCH_YIELD)
+            run_yield();
+        else if (workload == BENCH_PINGPONG)
+            run_pingpong(self, worker_count);
+        else
+            run_delay();
+
+        event_group_set(&done_event, 1U << self);
+    }
+}
+
+/**
+ * @brief Print one row of the result table.
+ * @param count The number of worker tasks.
+ * @param metric The name of the measured latency.
+ * @param stat The measured latency.
+ * @retval None
+ */
+static void print_row(uint8_t count, const char *metric, const BenchStat_Type *stat) {
+    uint32_t average = stat->samples ? (uint32_t)(stat->total / stat->samples) : 0;
+
+    printf(
+        "%u,%s,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n", count, workload_names[workload], metric,
+        stat->samples, stat->min, average, stat->max
+    );
+}
+
+/**
+ * @brief The controller task creates the workers, runs every workload at every task
+ *        count and prints the results. It runs at a higher priority than the workers
+ *        and sleeps while they run. The emulator is stopped once all phases are done.
+ * @param None
+ * @retval None
+ */
+static void bench_controller(void) {
+    printf("tasks,workload,metric,samples,min,avg,max\n");
+
+    for (size_t c = 0; c < sizeof(task_counts); ++c) {
+        while (worker_count < task_counts[c]) {
+            uint16_t task = task_create(bench_worker, DEFAULT_TASK_PRIORITY);
+            worker_index[task] = worker_count++;
+        }
+
+        for (uint8_t w = 0; w < BENCH_WORKLOADS; ++w) {
+            uint32_t workers = (1U << worker_count) - 1;
+
+            memset(&bench_tick_isr, 0, sizeof(bench_tick_isr));
+            memset(&switch_latency, 0, sizeof(switch_latency));
+            memset(&wake_latency, 0, sizeof(wake_latency));
+            event_group_clear(&token_event, EVENT_BITS_MASK);
+
+            workload = w;
+            phase_end = g_tick_count + BENCH_PHASE_TICKS;
+            bench_recording = 1;
+            wake_time = bench_now();
+            event_group_set(&start_event, workers);
+            if (w == BENCH_PINGPONG)
+                event_group_set(&token_event, 1U); // hand the token to the first worker
+
+            event_group_wait(&done_event, workers, EVENT_WAIT_ALL | EVENT_CLEAR_ON_EXIT, WAIT_FOREVER);
+            bench_recording = 0;
+
+            print_row(worker_count, "tick_isr", &bench_tick_isr);
+            if (w == BENCH_YIELD)
+                print_row(worker_count, "pendsv_to_resume", &switch_latency);
+            else
+                print_row(worker_count, "wake_latency", &wake_latency);
+        }
+    }
+
+    semihosting_exit();
+}
+
+int main(void) {
+    enable_processor_faults();
+    enable_cycle_counter();
+    bench_use_cycle_counter = (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0;
+
+    event_group_init(&start_event);
+    event_group_init(&done_event);
+    event_group_init(&token_event);
+
+    init_scheduler_stack(SCHED_STACK_START);
+    task_create(bench_controller, DEFAULT_TASK_PRIORITY + 1);
+    launch_scheduler(TICK_HZ_MS);
+}
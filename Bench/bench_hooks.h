@@ -0,0 +1,83 @@
+/**
+ ********************************************************
+ * @file    Bench/bench_hooks.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the scheduler hook
+ *          definitions used by the benchmark firmware to
+ *          timestamp the SysTick and PendSV handlers, and
+ *          the helpers to read and compare timestamps.
+ ********************************************************
+ */
+
+#ifndef __BENCH_HOOKS_H__
+#define __BENCH_HOOKS_H__
+
+#include "stm32f4xx.h"
+#include <stdint.h>
+
+/**
+ * @brief Running statistics of a measured latency in CPU cycles.
+ */
+typedef struct BenchStat {
+    uint32_t samples; /**< The number of measurements */
+    uint32_t min;     /**< The smallest measurement */
+    uint32_t max;     /**< The largest measurement */
+    uint64_t total;   /**< The sum of all measurements */
+} BenchStat_Type;
+
+extern volatile uint8_t bench_recording;
+extern volatile uint8_t bench_use_cycle_counter;
+extern volatile uint32_t bench_tick_entry;
+extern volatile uint32_t bench_pendsv_entry;
+extern BenchStat_Type bench_tick_isr;
+
+/**
+ * @brief Read a timestamp: the DWT cycle counter when it is enabled, otherwise the
+ *        SysTick counter, which is emulated by QEMU where the DWT is not.
+ * @param None
+ * @retval The current timestamp.
+ */
+static inline uint32_t bench_now(void) {
+    return bench_use_cycle_counter ? DWT->CYCCNT : SysTick->VAL;
+}
+
+/**
+ * @brief Get the number of cycles between two timestamps. With the SysTick counter,
+ *        which counts down from its reload value, the interval must be shorter than
+ *        one tick.
+ * @param start The earlier timestamp.
+ * @param end The later timestamp.
+ * @retval The number of cycles between the timestamps.
+ */
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end) {
+    if (bench_use_cycle_counter)
+        return end - start;
+
+    return (start - end + SysTick->LOAD + 1) % (SysTick->LOAD + 1);
+}
+
+/**
+ * @brief Add a measurement to a statistic.
+ * @param stat The statistic to update.
+ * @param cycles The measurement in cycles.
+ * @retval None
+ */
+static inline void bench_record(BenchStat_Type *stat, uint32_t cycles) {
+    if (!stat->samples || (cycles < stat->min))
+        stat->min = cycles;
+    if (cycles > stat->max)
+        stat->max = cycles;
+    stat->total += cycles;
+    stat->samples++;
+}
+
+#define SCHED_HOOK_TICK_ENTER() (bench_tick_entry = bench_now())
+#define SCHED_HOOK_TICK_EXIT()                                                                                         \
+    do {                                                                                                               \
+        if (bench_recording)                                                                                           \
+            bench_record(&bench_tick_isr, bench_elapsed(bench_tick_entry, bench_now()));                               \
+    } while (0)
+#define SCHED_HOOK_PENDSV_ENTER() (bench_pendsv_entry = bench_now())
+
+#endif // __BENCH_HOOKS_H__
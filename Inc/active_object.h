@@ -0,0 +1,58 @@
+/**
+ ********************************************************
+ * @file    Inc/active_object.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for active objects, which
+ *          handle the events posted to their queue to
+ *          completion, one at a time, with all objects of
+ *          a priority sharing one task and one stack.
+ ********************************************************
+ */
+
+#ifndef __ACTIVE_OBJECT_H__
+#define __ACTIVE_OBJECT_H__
+
+#include "scheduler.h"
+#include <stdint.h>
+
+#define ACTIVE_OBJECT_MAX_GROUPS 3 // maximum number of distinct priorities, each of which takes one task
+
+/**
+ * @brief An event. Events with parameters embed an `Event_Type` as their first
+ *        member; posting an event only queues a pointer to it, so the event must
+ *        stay valid and unchanged until it is dispatched, e.g. a `static const`
+ *        event or one the dispatch function releases.
+ */
+typedef struct Event {
+    uint16_t signal; /**< What happened, defined by the application */
+} Event_Type;
+
+/**
+ * @brief An active object. Its dispatch function is called by the task of its
+ *        priority for every event posted to the object, and runs to completion:
+ *        it must not block, since that would delay every object of the priority.
+ */
+typedef struct ActiveObject {
+    void (*dispatch)(struct ActiveObject *, const Event_Type *); /**< Handles one event */
+    void *context;                                               /**< User data available to `dispatch` */
+    const Event_Type **queue;                                    /**< Ring buffer of posted events */
+    uint8_t queue_size;                                          /**< The number of events `queue` can hold */
+    uint8_t head;                                                /**< Index the next event is posted to */
+    uint8_t tail;                                                /**< Index the next event is dispatched from */
+    uint8_t count;                                               /**< The number of queued events */
+    uint8_t max_count;                                           /**< The highest number of events queued at once */
+    uint32_t dropped;                                            /**< The number of events dropped on a full queue */
+    struct ActiveGroup *group;                                   /**< The objects of the priority, NULL until started */
+    struct ActiveObject *next;                                   /**< The next object of the same priority */
+} ActiveObject_Type;
+
+void active_object_init(
+    ActiveObject_Type *object, void (*dispatch)(ActiveObject_Type *object, const Event_Type *event), void *context,
+    const Event_Type **queue, uint8_t queue_size
+);
+uint8_t active_object_start(ActiveObject_Type *object, uint8_t priority);
+uint8_t active_object_post(ActiveObject_Type *object, const Event_Type *event);
+
+#endif // __ACTIVE_OBJECT_H__
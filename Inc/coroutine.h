@@ -0,0 +1,117 @@
+/**
+ ********************************************************
+ * @file    Inc/coroutine.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the macros, definitions
+ *          and function prototypes for stackless
+ *          coroutines, which are scheduled cooperatively
+ *          by a single coroutine task and share its
+ *          stack, so each one costs only its control
+ *          block instead of a task stack.
+ ********************************************************
+ */
+
+#ifndef __COROUTINE_H__
+#define __COROUTINE_H__
+
+#include "scheduler.h"
+#include <stdint.h>
+
+#ifndef COROUTINE_TASK_PRIORITY
+#define COROUTINE_TASK_PRIORITY DEFAULT_TASK_PRIORITY
+#endif
+
+/**
+ * @brief An enumeration to define the states of a coroutine,
+ *        which its body returns every time it waits
+ */
+enum coroutine_state {
+    COROUTINE_READY,   /**< The coroutine yielded and runs again after the other READY coroutines */
+    COROUTINE_DELAYED, /**< The coroutine waits until its `wake_tick` */
+    COROUTINE_WAITING, /**< The coroutine waits for a condition, checked again after `coroutine_notify()` */
+    COROUTINE_DONE     /**< The coroutine ended and can be started again */
+};
+
+/**
+ * @brief The control block of a stackless coroutine. The body
+ *        returns every time the coroutine waits and continues
+ *        at `resume_line` when it is called again, so local
+ *        variables of the body do not survive a wait; keep such
+ *        state in the structure `context` points to.
+ */
+typedef struct Coroutine {
+    uint8_t (*body)(struct Coroutine *co); /**< The coroutine's body, written with the `CO_*` macros */
+    void *context;                         /**< User data available to the body */
+    uint32_t wake_tick;                    /**< The tick count at which a delayed coroutine continues */
+    uint16_t resume_line;                  /**< The line the body continues at, or 0 to start from the top */
+    uint8_t state;                         /**< The state of the coroutine, see `enum coroutine_state` */
+    struct Coroutine *next;                /**< The next coroutine in the list the coroutine is in */
+} Coroutine_Type;
+
+/**
+ * @brief Start the body of a coroutine; every body begins with `CO_BEGIN()` and
+ *        ends with `CO_END()`. A wait resumes at its line number, so put at most
+ *        one wait on a line, and do not wait inside a `switch` statement.
+ */
+#define CO_BEGIN(co)                                                                                                   \
+    switch ((co)->resume_line) {                                                                                       \
+    case 0:
+
+/**
+ * @brief End the body of a coroutine.
+ */
+#define CO_END(co)                                                                                                     \
+    }                                                                                                                  \
+    (co)->resume_line = 0;                                                                                             \
+    return COROUTINE_DONE
+
+/**
+ * @brief Let the other READY coroutines run before continuing.
+ */
+#define CO_YIELD(co)                                                                                                   \
+    do {                                                                                                               \
+        (co)->resume_line = __LINE__;                                                                                  \
+        return COROUTINE_READY;                                                                                        \
+    case __LINE__:;                                                                                                    \
+    } while (0)
+
+/**
+ * @brief Wait for a number of ticks.
+ */
+#define CO_DELAY(co, ticks)                                                                                            \
+    do {                                                                                                               \
+        (co)->wake_tick = g_tick_count + (ticks);                                                                      \
+        (co)->resume_line = __LINE__;                                                                                  \
+        return COROUTINE_DELAYED;                                                                                      \
+    case __LINE__:;                                                                                                    \
+    } while (0)
+
+/**
+ * @brief Wait until a condition is true. The condition is checked again only
+ *        after `coroutine_notify()`, which whoever changes it must call.
+ */
+#define CO_WAIT_UNTIL(co, condition)                                                                                   \
+    do {                                                                                                               \
+        (co)->resume_line = __LINE__;                                                                                  \
+        if (0) {                                                                                                       \
+        case __LINE__:;                                                                                                \
+        }                                                                                                              \
+        if (!(condition))                                                                                              \
+            return COROUTINE_WAITING;                                                                                  \
+    } while (0)
+
+/**
+ * @brief End the coroutine from anywhere in its body.
+ */
+#define CO_EXIT(co)                                                                                                    \
+    do {                                                                                                               \
+        (co)->resume_line = 0;                                                                                         \
+        return COROUTINE_DONE;                                                                                         \
+    } while (0)
+
+void coroutine_start(Coroutine_Type *co, uint8_t (*body)(Coroutine_Type *co), void *context);
+void coroutine_notify(void);
+void coroutine_task(void);
+
+#endif // __COROUTINE_H__
@@ -0,0 +1,25 @@
+/**
+ ********************************************************
+ * @file    Inc/cpu_stats.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the function prototypes
+ *          for reading the CPU usage of every task, the
+ *          idle time and the moving average system load.
+ ********************************************************
+ */
+
+#ifndef __CPU_STATS_H__
+#define __CPU_STATS_H__
+
+#include <stdint.h>
+
+#define CPU_STATS_WINDOW 1000U    // number of ticks over which the CPU usage is measured
+#define CPU_STATS_AVERAGE_SHIFT 3 // the load average moves by 1/8 of the difference every window
+
+void cpu_stats_init(void);
+uint16_t cpu_stats_task_usage(uint16_t task);
+uint16_t cpu_stats_idle(void);
+uint16_t cpu_stats_load_average(void);
+
+#endif // __CPU_STATS_H__
@@ -0,0 +1,37 @@
+/**
+ ********************************************************
+ * @file    Inc/event_groups.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for event groups, which
+ *          let tasks block until any or all of a set of
+ *          event bits have been set by other tasks or
+ *          interrupt service routines.
+ ********************************************************
+ */
+
+#ifndef __EVENT_GROUPS_H__
+#define __EVENT_GROUPS_H__
+
+#include <stdint.h>
+
+#define EVENT_BITS_MASK 0x00FFFFFFU    // the lower 24 bits of an event group are usable event bits
+#define EVENT_WAIT_ALL (1U << 24)      // wait option: all requested bits must be set, instead of any
+#define EVENT_CLEAR_ON_EXIT (1U << 25) // wait option: clear the requested bits when the wait is satisfied
+
+/**
+ * @brief An event group holds a set of event bits
+ *        that tasks can wait on.
+ */
+typedef struct EventGroup {
+    volatile uint32_t bits; /**< The event bits currently set in the group */
+} EventGroup_Type;
+
+void event_group_init(EventGroup_Type *group);
+uint32_t event_group_set(EventGroup_Type *group, uint32_t bits);
+uint32_t event_group_clear(EventGroup_Type *group, uint32_t bits);
+uint32_t event_group_get(EventGroup_Type *group);
+uint32_t event_group_wait(EventGroup_Type *group, uint32_t bits, uint32_t options, uint32_t tick_count);
+
+#endif // __EVENT_GROUPS_H__
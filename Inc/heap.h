@@ -0,0 +1,43 @@
+/**
+ ********************************************************
+ * @file    Inc/heap.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for the Two-Level
+ *          Segregated Fit (TLSF) heap, which allocates
+ *          and frees memory in constant time and backs
+ *          malloc() and free() on the firmware.
+ ********************************************************
+ */
+
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HEAP_SL_LOG2 4      // every power of 2 size range is split into 2^4 free lists
+#define HEAP_FL_MAX_LOG2 24 // the largest block is smaller than 16 MiB
+
+/**
+ * @brief Statistics describing the usage and fragmentation of the heap.
+ */
+typedef struct HeapStats {
+    size_t size;            /**< The number of bytes managed by the heap */
+    size_t used;            /**< The number of bytes in allocated blocks, including their headers */
+    size_t peak_used;       /**< The highest number of bytes used at once */
+    size_t largest_free;    /**< The largest size `heap_alloc()` can currently allocate */
+    uint32_t free_blocks;   /**< The number of free blocks */
+    uint16_t fragmentation; /**< The share of free memory outside the largest free block in 0.01% */
+    uint32_t allocations;   /**< The number of successful allocations */
+    uint32_t failures;      /**< The number of allocations which failed for lack of a large enough block */
+} HeapStats_Type;
+
+void heap_init(void *start, size_t size);
+void *heap_alloc(size_t size);
+void heap_free(void *ptr);
+void *heap_realloc(void *ptr, size_t size);
+void heap_get_stats(HeapStats_Type *p_stats);
+
+#endif // __HEAP_H__
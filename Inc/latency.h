@@ -0,0 +1,84 @@
+/**
+ ********************************************************
+ * @file    Inc/latency.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the latency instrumentation
+ *          hooks and the function prototypes for building
+ *          and querying log-scale latency histograms. The
+ *          hooks expand to nothing unless the build
+ *          defines `SCHED_LATENCY`.
+ ********************************************************
+ */
+
+#ifndef __LATENCY_H__
+#define __LATENCY_H__
+
+#include "port.h"
+#include <stdint.h>
+
+#define LATENCY_BUCKETS 33U // bucket 0 counts zero cycles, bucket n counts [2^(n-1), 2^n) cycles
+
+/**
+ * @brief An enumeration to define the measured latencies
+ */
+enum latency_source {
+    LATENCY_SYSTICK,  /**< SysTick counter reload to `SysTick_Handler()` entry, i.e. the tick release jitter */
+    LATENCY_PENDSV,   /**< The SysTick handler pending PendSV to `PendSV_Handler()` entry */
+    LATENCY_CRITICAL, /**< Time spent with interrupts disabled by `enter_critical()` */
+    LATENCY_SOURCES
+};
+
+/**
+ * @brief A log-scale histogram of latencies in CPU cycles
+ */
+typedef struct LatencyHistogram {
+    uint32_t buckets[LATENCY_BUCKETS]; /**< The number of samples in every power of 2 range */
+    uint32_t count;                    /**< The total number of samples */
+    uint32_t min;                      /**< The smallest sample */
+    uint32_t max;                      /**< The largest sample */
+} LatencyHistogram_Type;
+
+/**
+ * @brief A summary of a latency histogram in CPU cycles. Percentiles are
+ *        the upper bound of the bucket they fall into, capped at `max`.
+ */
+typedef struct LatencyStats {
+    uint32_t count; /**< The total number of samples */
+    uint32_t min;   /**< The smallest sample */
+    uint32_t max;   /**< The largest sample */
+    uint32_t p50;   /**< The median */
+    uint32_t p90;   /**< The 90th percentile */
+    uint32_t p99;   /**< The 99th percentile */
+    uint32_t p999;  /**< The 99.9th percentile */
+} LatencyStats_Type;
+
+#ifdef SCHED_LATENCY
+
+#define LATENCY_TICK_ENTRY() latency_record(LATENCY_SYSTICK, SysTick->LOAD - SysTick->VAL)
+#define LATENCY_PENDSV_PENDED() latency_pendsv_pended()
+#define LATENCY_PENDSV_ENTRY() latency_pendsv_entry()
+#define LATENCY_CRITICAL_ENTER(primask) latency_critical_enter(primask)
+#define LATENCY_CRITICAL_EXIT(primask) latency_critical_exit(primask)
+
+void latency_record(uint8_t source, uint32_t cycles);
+void latency_pendsv_pended(void);
+void latency_pendsv_entry(void);
+void latency_critical_enter(uint32_t primask);
+void latency_critical_exit(uint32_t primask);
+void latency_get_histogram(uint8_t source, LatencyHistogram_Type *p_histogram);
+void latency_get_stats(uint8_t source, LatencyStats_Type *p_stats);
+void latency_reset(uint8_t source);
+void latency_print(void);
+
+#else
+
+#define LATENCY_TICK_ENTRY()
+#define LATENCY_PENDSV_PENDED()
+#define LATENCY_PENDSV_ENTRY()
+#define LATENCY_CRITICAL_ENTER(primask)
+#define LATENCY_CRITICAL_EXIT(primask)
+
+#endif // SCHED_LATENCY
+
+#endif // __LATENCY_H__
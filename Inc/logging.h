@@ -0,0 +1,82 @@
+/**
+ ********************************************************
+ * @file    Inc/logging.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the `LOG()` macro and the
+ *          function prototypes for deferred binary
+ *          logging. Only the address of the format string,
+ *          a timestamp and the raw arguments are recorded;
+ *          the text is expanded on the host by
+ *          `tools/log_decode.py` using the ELF file.
+ ********************************************************
+ */
+
+#ifndef __LOGGING_H__
+#define __LOGGING_H__
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_BUFFER_WORDS 64U // size of each per-task log buffer in 32-bit words; must be a power of 2
+#define LOG_MAX_ARGS 8U      // maximum number of arguments of a single log record
+#define LOG_DRAIN_PERIOD 10U // number of ticks the log task sleeps after draining all buffers
+
+#define LOG_FRAME_SYNC 0xA5U       // first byte of every frame sent to the host
+#define LOG_ISR_SOURCE 0xFFU       // source id of records logged from interrupt service routines
+#define LOG_DROPPED_FORMAT 0xFFFFU // format id of the frame reporting dropped records
+
+#ifndef LOG_TASK_PRIORITY
+#define LOG_TASK_PRIORITY (IDLE_TASK_PRIORITY + 1) // drain the log buffers only when the user tasks are idle
+#endif
+
+#if defined(PORT_POSIX) || defined(CONSOLE_SEMIHOSTING)
+
+/**
+ * @brief The host port and the semihosting console have no log task; messages
+ *        are printed directly, with the tick masked so a context switch cannot
+ *        interrupt stdio.
+ */
+#define LOG(fmt, ...)                                                                                                  \
+    do {                                                                                                               \
+        uint32_t log_primask = enter_critical();                                                                       \
+        printf(fmt, ##__VA_ARGS__);                                                                                    \
+        exit_critical(log_primask);                                                                                    \
+    } while (0)
+
+#else
+
+/**
+ * @brief Record a log message without formatting it. The format string is
+ *        placed in the `.log_strings` section, which is not loaded to the
+ *        target, and its offset in that section identifies the message. The
+ *        arguments are recorded as raw 32-bit words, so only integer, character
+ *        and pointer conversions are supported; `%s` and floating point
+ *        conversions are not.
+ */
+#define LOG(fmt, ...)                                                                                                  \
+    do {                                                                                                               \
+        static const char log_format[] __attribute__((section(".log_strings"), used)) = fmt;                           \
+        const uint32_t log_args[] = {0, ##__VA_ARGS__};                                                                \
+        log_record((uint32_t)log_format, &log_args[1], (sizeof(log_args) / sizeof(log_args[0])) - 1);                  \
+    } while (0)
+
+#endif // PORT_POSIX || CONSOLE_SEMIHOSTING
+
+/**
+ * @brief A single producer, single consumer ring buffer of log
+ *        records. Every task writes into its own buffer, so no
+ *        locking is needed between the task and the log task.
+ */
+typedef struct LogBuffer {
+    uint32_t words[LOG_BUFFER_WORDS]; /**< The encoded log records */
+    volatile uint32_t head;           /**< Free running index written only by the producer */
+    volatile uint32_t tail;           /**< Free running index written only by the log task */
+    volatile uint32_t dropped;        /**< The number of records dropped because the buffer was full */
+} LogBuffer_Type;
+
+void log_record(uint32_t format, const uint32_t *args, uint32_t nargs);
+void log_task(void);
+
+#endif // __LOGGING_H__
@@ -0,0 +1,35 @@
+/**
+ ********************************************************
+ * @file    Inc/mutex.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for recursive mutexes
+ *          which block the calling task while the
+ *          mutex is owned by another task.
+ ********************************************************
+ */
+
+#ifndef __MUTEX_H__
+#define __MUTEX_H__
+
+#include <stdint.h>
+
+#define MUTEX_NO_OWNER 0xFFFFU // owner value of a mutex which is not locked
+
+/**
+ * @brief A recursive mutex. The owning task can lock it again
+ *        and it is released once unlocked as many times. When
+ *        it is released, ownership is handed to a waiting task.
+ */
+typedef struct Mutex {
+    volatile uint16_t owner; /**< The index of the owning task in `user_tasks`, or `MUTEX_NO_OWNER` */
+    uint32_t count;          /**< The number of times the owner has locked the mutex */
+} Mutex_Type;
+
+void mutex_init(Mutex_Type *mutex);
+uint8_t mutex_lock(Mutex_Type *mutex, uint32_t tick_count);
+uint8_t mutex_unlock(Mutex_Type *mutex);
+void mutex_force_unlock(Mutex_Type *mutex);
+
+#endif // __MUTEX_H__
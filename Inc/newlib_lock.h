@@ -0,0 +1,21 @@
+/**
+ ********************************************************
+ * @file    Inc/newlib_lock.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the function prototypes
+ *          for checking and releasing the locks newlib is
+ *          given by the scheduler's retargeted locking
+ *          layer.
+ ********************************************************
+ */
+
+#ifndef __NEWLIB_LOCK_H__
+#define __NEWLIB_LOCK_H__
+
+#include <stdint.h>
+
+uint32_t newlib_lock_failures(void);
+void newlib_lock_release_task(uint16_t task);
+
+#endif // __NEWLIB_LOCK_H__
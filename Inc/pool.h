@@ -0,0 +1,58 @@
+/**
+ ********************************************************
+ * @file    Inc/pool.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the macros, definitions
+ *          and function prototypes for fixed-block memory
+ *          pools, which allocate and free blocks of one
+ *          size in constant time without fragmentation.
+ ********************************************************
+ */
+
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Define the storage of a pool: `count` blocks, each aligned and large
+ *        enough for a `type`, e.g. `static POOL_BLOCKS(frame_blocks, Frame_Type, 8);`.
+ */
+#define POOL_BLOCKS(name, type, count)                                                                                 \
+    union {                                                                                                            \
+        type block;                                                                                                    \
+        void *next;                                                                                                    \
+    } name[(count)]
+
+/**
+ * @brief Initialize a pool over storage defined with `POOL_BLOCKS()`.
+ */
+#define POOL_INIT(pool, blocks) pool_init((pool), (blocks), sizeof((blocks)[0]), sizeof(blocks) / sizeof((blocks)[0]))
+
+/**
+ * @brief Allocate a block of a pool as a pointer to the type of its blocks.
+ */
+#define POOL_ALLOC(pool, type) ((type *)pool_alloc(pool))
+
+/**
+ * @brief A pool of fixed-size blocks. Free blocks are kept in a singly linked
+ *        list through their first word, so the pool needs no memory besides
+ *        the blocks.
+ */
+typedef struct Pool {
+    uint8_t *blocks;      /**< The first block of the pool */
+    size_t block_size;    /**< The size of every block in bytes */
+    uint32_t block_count; /**< The number of blocks in the pool */
+    void *free_list;      /**< The first free block, or NULL if all blocks are in use */
+    uint32_t used;        /**< The number of blocks in use */
+    uint32_t max_used;    /**< The highest number of blocks in use at once */
+    uint32_t failures;    /**< The number of allocations which failed because all blocks were in use */
+} Pool_Type;
+
+void pool_init(Pool_Type *pool, void *blocks, size_t block_size, uint32_t block_count);
+void *pool_alloc(Pool_Type *pool);
+uint8_t pool_free(Pool_Type *pool, void *block);
+
+#endif // __POOL_H__
@@ -0,0 +1,36 @@
+/**
+ ********************************************************
+ * @file    Inc/port.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the interface between the
+ *          hardware independent kernel and a port, which
+ *          implements the context switch, the tick source
+ *          and interrupt masking for one architecture.
+ *          Every port provides a `portmacro.h` with its
+ *          own configuration in its directory under
+ *          `Port/`, which must be on the include path.
+ ********************************************************
+ */
+
+#ifndef __PORT_H__
+#define __PORT_H__
+
+#include "portmacro.h"
+#include <stdint.h>
+
+/* Implemented by the port and called by the kernel */
+
+uint32_t port_enter_critical(void);
+void port_exit_critical(uint32_t state);
+void port_pend_switch(void);
+uint8_t port_can_block(void);
+void port_init_task_stack(uint16_t task);
+void port_start_scheduler(uint32_t tick_period);
+
+/* Implemented by the kernel and called by the port */
+
+void sched_tick(void);
+void sched_switch_context(void);
+
+#endif // __PORT_H__
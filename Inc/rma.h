@@ -0,0 +1,54 @@
+/**
+ ********************************************************
+ * @file    Inc/rma.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for rate monotonic
+ *          priority assignment and the exact response
+ *          time analysis which admits periodic tasks.
+ *          The analysis does not depend on the kernel,
+ *          so `tools/rta.c` runs it on the host.
+ ********************************************************
+ */
+
+#ifndef __RMA_H__
+#define __RMA_H__
+
+#include <stdint.h>
+
+#define RMA_TICK_US 1000U             // the tick period in microseconds, `TICK_HZ_MS` on every port
+#define RMA_BASE_PRIORITY 4U          // lowest priority assigned, above the timer service and the work queue
+#define RMA_UNSCHEDULABLE 0xFFFFFFFFU // response time of a task which can miss its deadline
+
+#ifndef RMA_TICK_OVERHEAD_US
+#define RMA_TICK_OVERHEAD_US 0U // worst case time of the tick and context switch, measured with `make bench`
+#endif
+
+/**
+ * @brief An entry of a periodic task table, see `Inc/task_table.h`.
+ */
+#define RMA_TASK(handler, task_period, task_deadline, task_wcet)                                                       \
+    {.name = #handler, .task_handler = handler, .period = task_period, .deadline = task_deadline, .wcet = task_wcet},
+
+/**
+ * @brief A periodic task which is admitted only if it and all previously
+ *        admitted tasks meet their deadlines under rate monotonic priorities.
+ */
+typedef struct PeriodicTask {
+    const char *name;           /**< The name of the task, used by reports */
+    void (*task_handler)(void); /**< The task's handler function, which calls `task_delay()` once per job */
+    uint32_t period;            /**< The minimum time between two releases in ticks */
+    uint32_t deadline;          /**< The relative deadline in ticks, at most the period, or 0 for the period */
+    uint32_t wcet;              /**< The worst case execution time of a job in microseconds */
+    uint8_t priority;           /**< The priority assigned by `rma_assign_priorities()` */
+    uint32_t response_time;     /**< The worst case response time in microseconds, or `RMA_UNSCHEDULABLE` */
+} PeriodicTask_Type;
+
+uint8_t rma_assign_priorities(PeriodicTask_Type *tasks, uint32_t count);
+uint32_t rma_response_time(const PeriodicTask_Type *tasks, uint32_t count, uint32_t index);
+uint8_t rma_analyze(PeriodicTask_Type *tasks, uint32_t count);
+uint32_t rma_create_tasks(PeriodicTask_Type *tasks, uint32_t count);
+uint8_t rma_delete_task(uint16_t task);
+
+#endif // __RMA_H__
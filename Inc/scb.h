@@ -5,7 +5,8 @@
  * @date    09-January-2025
  * @brief   This file provides function prototypes for
  *          enabling processor faults in the system control
- *          block of the Cortex M4 microcontroller.
+ *          block of the Cortex M4 microcontroller and
+ *          enabling the DWT cycle counter.
  ********************************************************
  */
 
@@ -13,5 +14,6 @@
 #define __SCB_H__
 
 void enable_processor_faults(void);
+void enable_cycle_counter(void);
 
 #endif // __SCB_H__
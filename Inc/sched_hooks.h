@@ -0,0 +1,33 @@
+/**
+ ********************************************************
+ * @file    Inc/sched_hooks.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the instrumentation hooks
+ *          the scheduler calls at points of interest. The
+ *          hooks expand to nothing unless a build defines
+ *          `SCHED_HOOKS_FILE` to name a header which
+ *          provides its own definitions.
+ ********************************************************
+ */
+
+#ifndef __SCHED_HOOKS_H__
+#define __SCHED_HOOKS_H__
+
+#ifdef SCHED_HOOKS_FILE
+#include SCHED_HOOKS_FILE
+#endif
+
+#ifndef SCHED_HOOK_TICK_ENTER
+#define SCHED_HOOK_TICK_ENTER() // first statement of the SysTick handler
+#endif
+
+#ifndef SCHED_HOOK_TICK_EXIT
+#define SCHED_HOOK_TICK_EXIT() // last statement of the SysTick handler
+#endif
+
+#ifndef SCHED_HOOK_PENDSV_ENTER
+#define SCHED_HOOK_PENDSV_ENTER() // start of the context switch, before the next task is chosen
+#endif
+
+#endif // __SCHED_HOOKS_H__
@@ -6,7 +6,8 @@
  * @brief   This file provides macros for calculating
  *          stack boundaries for the tasks, function
  *          prototypes to initialize tasks and launch
- *          the round robin scheduler, and the definitions
+ *          the round robin or earliest deadline first
+ *          scheduler, and the definitions
  *          needed for the thread control block which
  *          describes a task to be executed.
  ********************************************************
@@ -15,22 +16,19 @@
 #ifndef __SCHEDULER_H__
 #define __SCHEDULER_H__
 
-#include "misc.h"
+#include "port.h"
 #include <stdint.h>
 
-#define MAX_TASKS 5 // 1 idle task (always ready; never blocked) + 4 user tasks
+#ifndef MAX_TASKS
+#define MAX_TASKS 8 // 1 idle task (always ready; never blocked) + up to 7 tasks created with `task_create()`
+#endif
 
-#define TICK_HZ_MS (HSI_VALUE / 1000U)
+#define IDLE_TASK_PRIORITY 0    // the idle task only runs when no other task is READY
+#define DEFAULT_TASK_PRIORITY 2 // tasks of equal priority are scheduled in a round robin fashion
 
-#define SIZE_TASK_STACK (1 * KiB)
-#define SIZE_SCHEDULER_STACK (1 * KiB)
-
-#define T0_STACK_START SRAM_END
-#define T1_STACK_START ((SRAM_END) - (1 * (SIZE_TASK_STACK)))
-#define T2_STACK_START ((SRAM_END) - (2 * (SIZE_TASK_STACK)))
-#define T3_STACK_START ((SRAM_END) - (3 * (SIZE_TASK_STACK)))
-#define IDLE_STACK_START ((SRAM_END) - (4 * (SIZE_TASK_STACK)))
-#define SCHED_STACK_START ((SRAM_END) - (5 * (SIZE_SCHEDULER_STACK)))
+#ifndef TIME_SLICE_TICKS
+#define TIME_SLICE_TICKS 1U // ticks a task runs before the next READY task of equal priority, unless set per task
+#endif
 
 /**
  *
@@ -39,24 +37,70 @@
  *
  */
 enum task_state {
-    READY,  /**< A task's state is marked as READY when it is ready to be scheduled */
-    BLOCKED /**< A task's state is marked as BLOCKED when it is doesn't need to be scheduled */
+    UNUSED,    /**< A task's state is marked as UNUSED when no task has been created in its slot */
+    READY,     /**< A task's state is marked as READY when it is ready to be scheduled */
+    BLOCKED,   /**< A task's state is marked as BLOCKED when it is doesn't need to be scheduled */
+    WAITING,   /**< A task's state is marked as WAITING when it is blocked on a kernel object without a timeout */
+    THROTTLED /**< A task's state is marked as THROTTLED when it used up its CPU budget until it is replenished */
 };
 
+#define WAIT_FOREVER 0xFFFFFFFFU // tick count passed to a blocking call to wait without a timeout
+
 /**
  * @brief The Thread Control Block contains thread-specific
  *        information needed to manage the thread.
  */
 typedef struct TCB {
-    uint32_t psp_value;         /**< The current address of the task's stack pointer */
+    uint32_t psp_value;         /**< The current address of the task's stack pointer, if the port uses it */
     uint32_t block_count;       /**< The total count a task should delay in reference to systick */
     uint8_t current_state;      /**< The current state the task is in */
+    uint8_t priority;           /**< The task's priority; higher values are scheduled first */
+    uint16_t time_slice;        /**< Ticks the task runs before a task of equal priority, or 0 for the default */
+    uint16_t slice_left;        /**< Ticks left of the task's time slice, kept while it is preempted */
     void (*task_handler)(void); /**< The task's handler function */
+    uint32_t relative_deadline; /**< Ticks from a release to the deadline of the job, or 0 for none */
+    uint32_t absolute_deadline; /**< The tick count at which the current job is due */
+    uint32_t deadline_misses;   /**< The number of jobs completed after their deadline */
+    uint32_t worst_lateness;    /**< The most ticks a job completed after its deadline, rounded up */
+    uint32_t overruns;          /**< The number of releases skipped because a job overran its period */
+    void *wait_object;          /**< The kernel object the task is blocked on, or NULL */
+    uint32_t wait_value;        /**< Object specific value describing what the task waits for */
+#ifdef PORT_NEWLIB_REENT
+    struct _reent reent; /**< The task's newlib state (errno, stdio, ...) switched in by PendSV */
+#endif
+    uint64_t run_time;          /**< The total time the task has been running, in timestamp counts */
+    uint32_t budget;            /**< CPU time allowed every `budget_period` in timestamp counts, or 0 for no limit */
+    uint32_t budget_period;     /**< The number of ticks between replenishments of the budget */
+    int32_t budget_left;        /**< CPU time left until the next replenishment, negative after an overrun */
+    uint32_t replenish_tick;    /**< The tick count at which the budget is next replenished */
+    uint16_t generation;        /**< Incremented every time a task is created in the slot */
 } TCB_Type;
 
-void init_tasks_stack(void);
+extern uint16_t current_task;
+extern uint32_t g_tick_count;
+extern TCB_Type user_tasks[MAX_TASKS];
+
+uint16_t task_create(void (*task_handler)(void), uint8_t priority);
+void task_delete(uint16_t task);
+void task_exit(void) __attribute__((noreturn));
+void task_set_deadline(uint16_t task, uint32_t relative_deadline);
+void task_set_priority(uint16_t task, uint8_t priority);
+void task_set_time_slice(uint16_t task, uint16_t ticks);
+void task_set_budget(uint16_t task, uint32_t budget, uint32_t period);
+void task_set_deadline_callback(void (*callback)(uint16_t task, uint32_t lateness));
 void task_delay(uint32_t tick_count);
-void launch_scheduler(uint32_t systick_hz);
-__attribute__((naked)) void init_scheduler_stack(uint32_t scheduler_stack_start);
+void task_delay_until(uint32_t *release_tick, uint32_t period);
+void task_yield(void);
+uint32_t enter_critical(void);
+void exit_critical(uint32_t primask);
+void task_wait(void *wait_object, uint32_t wait_value, uint32_t tick_count);
+void task_wake(uint16_t task);
+uint8_t task_can_block(void);
+uint32_t read_timestamp(void);
+void update_run_time(void);
+void launch_scheduler(uint32_t tick_period);
+#ifdef SCHED_EDF
+uint8_t sched_check_ready_heap(void);
+#endif
 
 #endif // __SCHEDULER_H__
@@ -0,0 +1,19 @@
+/**
+ ********************************************************
+ * @file    Inc/semihosting.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the function prototypes
+ *          for writing to the console of the debugger or
+ *          emulator through Arm semihosting and for
+ *          ending the emulation.
+ ********************************************************
+ */
+
+#ifndef __SEMIHOSTING_H__
+#define __SEMIHOSTING_H__
+
+int semihosting_write(const char *data, int len);
+void semihosting_exit(void) __attribute__((noreturn));
+
+#endif // __SEMIHOSTING_H__
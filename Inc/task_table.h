@@ -0,0 +1,28 @@
+/**
+ ********************************************************
+ * @file    Inc/task_table.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the table of periodic
+ *          tasks of the application, shared by the
+ *          firmware, which admits them at startup, and
+ *          the host tool `tools/rta.c`, which checks
+ *          that they meet their deadlines.
+ ********************************************************
+ */
+
+#ifndef __TASK_TABLE_H__
+#define __TASK_TABLE_H__
+
+/**
+ * @brief The periodic tasks as `TASK(handler, period, deadline, wcet)`, with the
+ *        period and deadline in ticks, a deadline of 0 meaning the period, and the
+ *        worst case execution time in microseconds.
+ */
+#define PERIODIC_TASK_TABLE(TASK)                                                                                      \
+    TASK(task_0_handler, 125, 0, 100)                                                                                  \
+    TASK(task_1_handler, 250, 0, 100)                                                                                  \
+    TASK(task_2_handler, 500, 0, 100)                                                                                  \
+    TASK(task_3_handler, 1000, 0, 100)
+
+#endif // __TASK_TABLE_H__
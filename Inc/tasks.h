@@ -4,17 +4,25 @@
  * @author  Jacob Zarnstorff
  * @date    09-January-2025
  * @brief   This file contains function
- *          prototypes for task handlers
+ *          prototypes for task handlers and the
+ *          table of periodic tasks
  ********************************************************
  */
 
 #ifndef __TASKS_H__
 #define __TASKS_H__
 
+#include "rma.h"
+#include <stdint.h>
+
+extern PeriodicTask_Type periodic_tasks[];
+extern const uint32_t periodic_task_count;
+
 void idle_task(void);
 void task_0_handler(void);
 void task_1_handler(void);
 void task_2_handler(void);
 void task_3_handler(void);
+void deadline_miss_handler(uint16_t task, uint32_t lateness);
 
 #endif // __TASKS_H__
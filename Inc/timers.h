@@ -0,0 +1,50 @@
+/**
+ ********************************************************
+ * @file    Inc/timers.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for one-shot and
+ *          auto-reload software timers whose callbacks
+ *          are executed by the timer service task.
+ ********************************************************
+ */
+
+#ifndef __TIMERS_H__
+#define __TIMERS_H__
+
+#include <stdint.h>
+
+/**
+ * @brief An enumeration to define how a software
+ *        timer behaves after it expires
+ */
+enum timer_mode {
+    TIMER_ONE_SHOT,   /**< The timer stops after its callback is executed once */
+    TIMER_AUTO_RELOAD /**< The timer is restarted with the same period every time it expires */
+};
+
+/**
+ * @brief A software timer driven by the SysTick count. Timers
+ *        are kept in a list sorted by expiry tick which is
+ *        serviced by a single timer service task.
+ */
+typedef struct SoftTimer {
+    void (*callback)(struct SoftTimer *timer); /**< The function executed by the timer service task on expiry */
+    void *context;                             /**< User data available to the callback */
+    uint32_t period;                           /**< The timer period in number of ticks */
+    uint32_t expiry;                           /**< The tick count at which the timer next expires */
+    uint8_t mode;                              /**< One-shot or auto-reload, see `enum timer_mode` */
+    uint8_t active;                            /**< Non-zero while the timer is in the active list */
+    struct SoftTimer *next;                    /**< The next timer in the active list */
+} SoftTimer_Type;
+
+void timer_init(
+    SoftTimer_Type *timer, void (*callback)(SoftTimer_Type *timer), void *context, uint32_t period, uint8_t mode
+);
+void timer_start(SoftTimer_Type *timer);
+void timer_stop(SoftTimer_Type *timer);
+uint8_t timer_is_active(SoftTimer_Type *timer);
+void timer_service_task(void);
+
+#endif // __TIMERS_H__
@@ -0,0 +1,85 @@
+/**
+ ********************************************************
+ * @file    Inc/trace.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the scheduler trace hooks
+ *          and the function prototypes for recording
+ *          scheduling events into a RAM ring buffer and
+ *          sending them to the host, where they are
+ *          converted by `tools/trace_to_perfetto.py`.
+ *          The hooks expand to nothing unless the build
+ *          defines `SCHED_TRACE`.
+ ********************************************************
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "scheduler.h"
+#include <stdint.h>
+
+#define TRACE_BUFFER_SIZE 512U   // number of records kept in the ring buffer; must be a power of 2
+#define TRACE_FRAME_RECORDS 32U  // maximum number of records sent to the host in a single frame
+#define TRACE_STREAM_PERIOD 10U  // number of ticks the trace task sleeps after sending all new records
+#define TRACE_FRAME_MAGIC "TRC2" // first bytes of every frame sent to the host
+
+#ifndef TRACE_TASK_PRIORITY
+#define TRACE_TASK_PRIORITY (IDLE_TASK_PRIORITY + 1) // stream the trace only when the user tasks are idle
+#endif
+
+/**
+ * @brief An enumeration to define the events
+ *        recorded in the trace buffer
+ */
+enum trace_event {
+    TRACE_SWITCH_OUT = 1, /**< The task stops running; `arg` is its state */
+    TRACE_SWITCH_IN,      /**< The task starts running */
+    TRACE_BLOCK,          /**< The task blocks; `arg` is the number of ticks or 0 when waiting forever */
+    TRACE_UNBLOCK,        /**< The task is made READY by a tick or a kernel object */
+    TRACE_TICK,           /**< The SysTick handler ran; `arg` is the low half of the tick count */
+    TRACE_ISR_ENTER,      /**< An interrupt handler was entered; `arg` is the exception number */
+    TRACE_ISR_EXIT        /**< An interrupt handler returns; `arg` is the exception number */
+};
+
+/**
+ * @brief A single scheduling event, sent to the host as
+ *        9 bytes in little endian byte order
+ */
+typedef struct TraceRecord {
+    uint32_t timestamp; /**< The time of the event in CPU cycles, from `read_timestamp()` */
+    uint8_t event;      /**< The type of the event */
+    uint16_t task;      /**< The task the event refers to, or the running task for ticks and ISRs */
+    uint16_t arg;       /**< Event specific argument */
+} TraceRecord_Type;
+
+#ifdef SCHED_TRACE
+
+#define TRACE_TASK_SWITCH_OUT(task) trace_record(TRACE_SWITCH_OUT, (task), user_tasks[(task)].current_state)
+#define TRACE_TASK_SWITCH_IN(task) trace_record(TRACE_SWITCH_IN, (task), 0)
+#define TRACE_TASK_BLOCK(task, ticks) trace_record(TRACE_BLOCK, (task), (uint16_t)(ticks))
+#define TRACE_TASK_UNBLOCK(task) trace_record(TRACE_UNBLOCK, (task), 0)
+#define TRACE_TICK() trace_record(TRACE_TICK, current_task, (uint16_t)g_tick_count)
+#define TRACE_ISR_ENTER() trace_record(TRACE_ISR_ENTER, current_task, (uint16_t)__get_IPSR())
+#define TRACE_ISR_EXIT() trace_record(TRACE_ISR_EXIT, current_task, (uint16_t)__get_IPSR())
+
+void trace_record(uint8_t event, uint16_t task, uint16_t arg);
+void trace_start(void);
+void trace_stop(void);
+uint32_t trace_read(TraceRecord_Type *records, uint32_t max_records, uint32_t *p_lost);
+void trace_dump(void);
+void trace_task(void);
+
+#else
+
+#define TRACE_TASK_SWITCH_OUT(task)
+#define TRACE_TASK_SWITCH_IN(task)
+#define TRACE_TASK_BLOCK(task, ticks)
+#define TRACE_TASK_UNBLOCK(task)
+#define TRACE_TICK()
+#define TRACE_ISR_ENTER()
+#define TRACE_ISR_EXIT()
+
+#endif // SCHED_TRACE
+
+#endif // __TRACE_H__
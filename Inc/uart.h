@@ -5,7 +5,9 @@
  * @date    09-January-2025
  * @brief   This file contains function prototypes for
  *          to enable TX pin on USART2 for the STM32F4xx
- *          microcontroller.
+ *          microcontroller, to write data through the
+ *          double buffered DMA transmit path and to
+ *          receive data through the DMA receive path.
  ********************************************************
  */
 
@@ -14,6 +16,27 @@
 
 #include <stdint.h>
 
+#define UART_TX_BUFFER_SIZE 256U // size of each of the two DMA transmit buffers
+#define UART_RX_BUFFER_SIZE 512U // size of the circular DMA receive buffer
+#define UART_RX_QUEUE_SIZE 16U   // maximum number of received chunks waiting for a task
+
+/**
+ * @brief A chunk of received data which points directly
+ *        into the DMA receive buffer.
+ */
+typedef struct UartRxChunk {
+    const uint8_t *data;    /**< The first received byte of the chunk */
+    uint16_t len;           /**< The number of bytes in the chunk */
+    uint8_t end_of_frame;   /**< Non-zero if the line went idle after this chunk */
+    uint32_t stream_offset; /**< The number of bytes received before the chunk */
+} UartRxChunk_Type;
+
 void init_usart2_tx(uint32_t baud_rate);
+void init_usart2_rx(void);
+int uart_write(const char *data, int len);
+uint8_t uart_rx_receive(UartRxChunk_Type *chunk, uint32_t tick_count);
+int uart_read(char *data, int len);
+uint8_t uart_rx_chunk_intact(const UartRxChunk_Type *chunk);
+uint32_t uart_rx_overruns(void);
 
 #endif // __UART_H__
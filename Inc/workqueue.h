@@ -0,0 +1,64 @@
+/**
+ ********************************************************
+ * @file    Inc/workqueue.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the definitions and
+ *          function prototypes for the deferred work
+ *          queue, which lets interrupt service routines
+ *          hand heavy processing to a worker task.
+ ********************************************************
+ */
+
+#ifndef __WORKQUEUE_H__
+#define __WORKQUEUE_H__
+
+#include "scheduler.h"
+#include <stdint.h>
+
+#define WORKQUEUE_SIZE 16 // maximum number of distinct work items pending at once
+
+#ifndef WORKQUEUE_TASK_PRIORITY
+#define WORKQUEUE_TASK_PRIORITY (DEFAULT_TASK_PRIORITY + 1) // run deferred work ahead of the user tasks
+#endif
+
+/**
+ * @brief An enumeration to define the results
+ *        of posting a work item to the queue
+ */
+enum work_post_result {
+    WORK_QUEUED,    /**< The work item was added to the queue */
+    WORK_COALESCED, /**< The work item was already pending and was not added again */
+    WORK_QUEUE_FULL /**< The queue is full and the work item was dropped */
+};
+
+/**
+ * @brief A unit of deferred work. A work item is pending at most
+ *        once in the queue, so posting it repeatedly before the
+ *        worker task runs it executes the handler only once.
+ */
+typedef struct WorkItem {
+    void (*handler)(struct WorkItem *work); /**< The function executed by the worker task */
+    void *context;                          /**< User data available to the handler */
+    volatile uint8_t pending;               /**< Non-zero while the work item is in the queue */
+    uint32_t post_cycles;                   /**< Cycle count when the work item was first posted */
+} WorkItem_Type;
+
+/**
+ * @brief Statistics describing the load on the deferred work queue.
+ */
+typedef struct WorkQueueStats {
+    uint32_t depth;              /**< The number of work items currently pending */
+    uint32_t max_depth;          /**< The highest number of work items pending at once */
+    uint32_t posted;             /**< The number of work items added to the queue */
+    uint32_t coalesced;          /**< The number of posts merged into an already pending work item */
+    uint32_t dropped;            /**< The number of posts rejected because the queue was full */
+    uint32_t max_latency_cycles; /**< The worst-case cycles between posting and starting a work item */
+} WorkQueueStats_Type;
+
+void work_init(WorkItem_Type *work, void (*handler)(WorkItem_Type *work), void *context);
+uint8_t work_post(WorkItem_Type *work);
+void workqueue_get_stats(WorkQueueStats_Type *p_stats);
+void workqueue_task(void);
+
+#endif // __WORKQUEUE_H__
@@ -0,0 +1,259 @@
+/**
+ ********************************************************
+ * @file    Port/cortex_m4/port.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the Cortex M4 port of the
+ *          kernel: the SysTick timer used as the tick
+ *          source, interrupt masking with PRIMASK, the
+ *          initial stack frame of a task and the PendSV
+ *          handler which switches context between tasks.
+ ********************************************************
+ */
+
+#include "latency.h"
+#include "port.h"
+#include "scheduler.h"
+#include "stm32f4xx.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief Disable interrupts and return the previous interrupt mask.
+ * @param None
+ * @retval The value of PRIMASK before interrupts were disabled.
+ */
+uint32_t port_enter_critical(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+/**
+ * @brief Restore the interrupt mask saved by `port_enter_critical()`.
+ * @param state The value returned by the matching call to `port_enter_critical()`.
+ * @retval None
+ */
+void port_exit_critical(uint32_t state) {
+    __set_PRIMASK(state);
+}
+
+/**
+ * @brief Pend the PendSV exception, which switches context once interrupts are
+ *        enabled and no other exception is active.
+ * @param None
+ * @retval None
+ */
+void port_pend_switch(void) {
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+}
+
+/**
+ * @brief Check if the caller runs in thread mode on the Process Stack Pointer (PSP),
+ *        i.e. in a task after the scheduler has been launched.
+ * @param None
+ * @retval Non-zero if the caller runs in a task.
+ */
+uint8_t port_can_block(void) {
+    return (__get_IPSR() == 0) && (__get_CONTROL() & CONTROL_SPSEL_Msk);
+}
+
+/**
+ * @brief Initialize the newlib reentrancy structure of a task and a dummy stack frame
+ *        at the top of the stack that belongs to its slot, so the first context switch
+ *        to the task starts its handler.
+ * @param task The index of the task in `user_tasks`.
+ * @retval None
+ */
+void port_init_task_stack(uint16_t task) {
+    uint32_t *p_PSP = (uint32_t *)TASK_STACK_START(task);
+
+    _REENT_INIT_PTR(&user_tasks[task].reent);
+
+    --p_PSP;
+    *p_PSP = xPSR_T_Msk;
+
+    --p_PSP; // program counter
+    *p_PSP = (uint32_t)user_tasks[task].task_handler;
+
+    --p_PSP; // link register, so a handler which returns exits the task
+    *p_PSP = (uint32_t)task_exit;
+
+    // configure CPU registers R0-R12 with dummy
+    // values of 0 in task's private stack
+    for (unsigned char j = 0; j < 13; ++j) {
+        --p_PSP;
+        *p_PSP = 0;
+    }
+
+    user_tasks[task].psp_value = (uint32_t)p_PSP;
+}
+
+/**
+ * @brief Read a free running timestamp in CPU cycles. The DWT cycle counter is used
+ *        when present and enabled by `enable_cycle_counter()`; otherwise the timestamp
+ *        is derived from the global tick count and the current value of the SysTick
+ *        counter, which counts down, plus a tick the tick handler has yet to count.
+ * @param None
+ * @retval The current timestamp in CPU cycles.
+ */
+uint32_t read_timestamp(void) {
+    uint32_t tick_count;
+    uint32_t systick_value;
+    uint32_t tick_pending;
+
+    if (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) // reads as zero when there is no cycle counter
+        return DWT->CYCCNT;
+
+    do {
+        tick_count = g_tick_count;
+        systick_value = SysTick->VAL;
+        // with interrupts disabled, e.g. in PendSV, the counter may have reloaded
+        // before the tick handler counted the tick
+        tick_pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ? 1 : 0;
+        if (tick_pending)
+            systick_value = SysTick->VAL; // read again after the reload
+    } while (tick_count != g_tick_count); // retry if a tick occurred in between
+
+    return ((tick_count + tick_pending) * (SysTick->LOAD + 1)) + (SysTick->LOAD - systick_value);
+}
+
+/**
+ * @brief Set the address for the Main Stack Pointer (MSP) of the Cortex M4 microcontroller.
+ * @param scheduler_stack_start The desired address in RAM the MSP should point to.
+ * @retval None
+ */
+__attribute__((naked)) void init_scheduler_stack(uint32_t scheduler_stack_start) {
+    __set_MSP(scheduler_stack_start);
+    __asm volatile("BX LR");
+}
+
+/**
+ * @brief Get the Process Stack Pointer (PSP) address of the current running task.
+ * @param None
+ * @retval The address of the current task's stack pointer.
+ */
+static uint32_t get_psp_value(void) {
+    return user_tasks[current_task].psp_value;
+}
+
+/**
+ * @brief Update the Process Stack Pointer (PSP) address of the current running task to a new value.
+ * @param current_psp_value The new address of the current task's stack pointer.
+ * @retval None
+ */
+static void save_psp_value(uint32_t current_psp_value) {
+    user_tasks[current_task].psp_value = current_psp_value;
+}
+
+/**
+ * @brief Point newlib's reentrancy pointer at the state of `current_task`, so
+ *        errno, stdio and the other per-thread state of newlib belong to it.
+ *        Called by PendSV once the next task has been chosen.
+ * @param None
+ * @retval None
+ */
+static void switch_reent(void) {
+    _impure_ptr = &user_tasks[current_task].reent;
+}
+
+/**
+ * @brief Switch from using the Main Stack Pointer (MSP) to the Process Stack Pointer (PSP).
+ * @param None
+ * @retval None
+ */
+__attribute__((naked)) static void switch_sp_to_psp(void) {
+    // initialize the PSP with TASK1 stack start
+
+    // get the value of PSP of current_task
+    __asm volatile("PUSH {LR}");        // preserve LR which returns back to main
+    __asm volatile("BL get_psp_value"); // stack of current_task will be stored in R0
+    __asm volatile("MSR PSP, R0");      // initialize PSP
+    __asm volatile("POP {LR}");         // pops back LR value
+
+    // change SP to PSP using CONTROL register
+    __asm volatile("MOV R0, #0X02");
+    __asm volatile("MSR CONTROL, R0");
+    __asm volatile("BX LR");
+}
+
+/**
+ * @brief Initialize the SysTick timer, switch from using the Main Stack Pointer (MSP)
+ *        to the Process Stack Pointer (PSP), and call the task handler of the current
+ *        task, which exits the task if it returns.
+ * @param tick_period Value in CPU cycles between SysTick interrupts.
+ * @retval None
+ */
+void port_start_scheduler(uint32_t tick_period) {
+    NVIC_SetPriority(PendSV_IRQn, (1U << __NVIC_PRIO_BITS) - 1); // lowest, switch only after all ISRs
+    SysTick_Config(tick_period);
+    switch_sp_to_psp();
+    switch_reent();
+    user_tasks[current_task].task_handler();
+    task_exit(); // the first task was called directly, so it returns here instead of through its LR
+}
+
+/**
+ * @brief Interrupt Service Routine for the PendSV exception which handles the
+ *        context switching between tasks. The PendSV exception is chosen to do
+ *        the context switching due to the exception having the lowest priority.
+ *        If the context switching was carried out in an interrupt with a very
+ *        high priority like the SysTick handler, there could be a possibility
+ *        of an interrupt with a lower priority being pre-empted in the middle
+ *        of an ISR by the SysTick hanlder. This would lead to the context being
+ *        switched back to a task instead of returning to back the ISR that was
+ *        interrupted leading to a UsageFault. Interrupts are disabled while the
+ *        kernel chooses the next task, since any ISR may call `task_wake()`.
+ * @param None
+ * @retval None
+ */
+__attribute__((naked)) void PendSV_Handler(void) {
+    /* Save the context of current_task */
+    // get current running task's PSP value
+    __asm volatile("MRS R0, PSP");
+
+    // using that PSP value, store SF2 [R4:R11]
+    // STMDB = store multiple registers and decrement before
+    __asm volatile("STMDB R0!, {R4-R11}");
+
+    // save the current value of PSP
+    __asm volatile("PUSH {LR}");
+    __asm volatile("CPSID I"); // ISRs calling `task_wake()` must not see the task state half updated
+    __asm volatile("BL save_psp_value");
+
+    /* Retrieve the context of next task */
+    // charge the time since the last switch to current_task and decide next task to run
+    __asm volatile("BL sched_switch_context");
+
+    // switch newlib's per-task state to the next task
+    __asm volatile("BL switch_reent");
+    __asm volatile("CPSIE I"); // PRIMASK was clear, or PendSV would not have been taken
+
+    // get its past PSP value
+    __asm volatile("BL get_psp_value");
+
+    // using that PSP value, retrieve SF2 [R4:R11]
+    // LDMIA = load multiple registers and increment after
+    __asm volatile("LDMIA R0!, {R4-R11}");
+
+    // update PSP and exit
+    __asm volatile("MSR PSP, R0");
+    __asm volatile("POP {LR}");
+    __asm volatile("BX LR");
+}
+
+/**
+ * @brief Interrupt Service Routine for the SysTick exception which lets the
+ *        kernel update the tick count, unblock tasks and pend a context switch.
+ *        SysTick shares the lowest priority with PendSV, so interrupts are
+ *        disabled to keep ISRs calling `task_wake()` out of the kernel.
+ * @param None
+ * @retval None
+ */
+void SysTick_Handler(void) {
+    LATENCY_TICK_ENTRY(); // must come first, as it samples the SysTick counter
+    uint32_t primask = enter_critical();
+
+    sched_tick();
+    exit_critical(primask);
+}
@@ -0,0 +1,41 @@
+/**
+ ********************************************************
+ * @file    Port/cortex_m4/portmacro.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the configuration of the
+ *          Cortex M4 port: the location of the task and
+ *          scheduler stacks in SRAM, the tick period and
+ *          the function prototypes which only exist on
+ *          the target.
+ ********************************************************
+ */
+
+#ifndef __PORTMACRO_H__
+#define __PORTMACRO_H__
+
+#include "misc.h"
+#include <reent.h>
+#include <stdint.h>
+
+#define PORT_NEWLIB_REENT // every task has its own newlib state, switched by PendSV
+
+#define TICK_HZ_MS (HSI_VALUE / 1000U) // SysTick reload value for a 1 ms tick
+
+#define SIZE_TASK_STACK (1 * KiB)
+#define SIZE_SCHEDULER_STACK (1 * KiB)
+
+#define TASK_STACK_START(task) ((SRAM_END) - ((task) * (SIZE_TASK_STACK))) // the idle task (0) is at the top
+#define SCHED_STACK_START ((SRAM_END) - ((MAX_TASKS) * (SIZE_TASK_STACK)))
+
+/**
+ * @brief Called by the idle task in a loop.
+ * @param None
+ * @retval None
+ */
+static inline void port_idle(void) {
+}
+
+__attribute__((naked)) void init_scheduler_stack(uint32_t scheduler_stack_start);
+
+#endif // __PORTMACRO_H__
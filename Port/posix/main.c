@@ -0,0 +1,50 @@
+/**
+ ********************************************************
+ * @file    Port/posix/main.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the entry point of the
+ *          host build, which runs the same tasks as the
+ *          firmware, except the ones that drive USART2,
+ *          and reports the CPU load every second.
+ ********************************************************
+ */
+
+#include "cpu_stats.h"
+#include "logging.h"
+#include "rma.h"
+#include "scheduler.h"
+#include "tasks.h"
+#include "timers.h"
+#include "workqueue.h"
+#include <stdio.h>
+
+/**
+ * @brief A task which prints the CPU usage of every task once per second.
+ * @param None
+ * @retval None
+ */
+static void report_task(void) {
+    while (1) {
+        task_delay(CPU_STATS_WINDOW);
+        LOG("load %u.%02u%%", cpu_stats_load_average() / 100, cpu_stats_load_average() % 100);
+        LOG(", idle %u.%02u%%", cpu_stats_idle() / 100, cpu_stats_idle() % 100);
+        for (uint16_t i = 1; i < MAX_TASKS; ++i)
+            if (user_tasks[i].current_state != UNUSED)
+                LOG(", task %u %u.%02u%%", i, cpu_stats_task_usage(i) / 100, cpu_stats_task_usage(i) % 100);
+        LOG("\n");
+    }
+}
+
+int main(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    task_set_deadline_callback(deadline_miss_handler);
+    if (!rma_create_tasks(periodic_tasks, periodic_task_count))
+        printf("Periodic tasks rejected: deadlines can be missed\n");
+    task_create(timer_service_task, DEFAULT_TASK_PRIORITY);
+    task_create(workqueue_task, WORKQUEUE_TASK_PRIORITY);
+    task_create(report_task, DEFAULT_TASK_PRIORITY);
+    cpu_stats_init();
+    launch_scheduler(TICK_HZ_MS);
+}
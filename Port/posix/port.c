@@ -0,0 +1,194 @@
+/**
+ ********************************************************
+ * @file    Port/posix/port.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the POSIX host port of
+ *          the kernel. Every task runs on its own stack
+ *          as a `ucontext`, an interval timer raises
+ *          `SIGALRM` as the tick interrupt, and blocking
+ *          `SIGALRM` takes the place of disabling
+ *          interrupts. Like PendSV on the target, a
+ *          context switch requested while interrupts are
+ *          disabled or from the tick handler is deferred
+ *          until interrupts are enabled again.
+ ********************************************************
+ */
+
+#define _GNU_SOURCE
+
+#include "port.h"
+#include "scheduler.h"
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+
+static ucontext_t contexts[MAX_TASKS];
+static uint8_t stacks[MAX_TASKS][SIZE_TASK_STACK] __attribute__((aligned(16)));
+static sigset_t tick_signal;                     // the set containing only `SIGALRM`
+static volatile sig_atomic_t in_tick = 0;        // set while the tick handler runs
+static volatile sig_atomic_t switch_pending = 0; // set when a context switch has been requested
+static uint8_t scheduler_started = 0;
+
+/**
+ * @brief Block the tick signal and return whether it was blocked before.
+ * @param None
+ * @retval 1 if interrupts were already disabled, 0 otherwise.
+ */
+uint32_t port_enter_critical(void) {
+    sigset_t previous;
+
+    sigprocmask(SIG_BLOCK, &tick_signal, &previous);
+    return sigismember(&previous, SIGALRM) ? 1 : 0;
+}
+
+/**
+ * @brief Switch context to the task chosen by the kernel. Must be called with the
+ *        tick signal blocked. The signal mask is part of every saved context, so
+ *        each task resumes with the mask it was switched out with.
+ * @param None
+ * @retval None
+ */
+static void switch_context(void) {
+    uint16_t previous = current_task;
+
+    switch_pending = 0;
+    sched_switch_context();
+    if (current_task != previous)
+        swapcontext(&contexts[previous], &contexts[current_task]);
+}
+
+/**
+ * @brief Restore the signal mask saved by `port_enter_critical()`, performing a
+ *        pending context switch first if interrupts are enabled again.
+ * @param state The value returned by the matching call to `port_enter_critical()`.
+ * @retval None
+ */
+void port_exit_critical(uint32_t state) {
+    if (state)
+        return;
+
+    if (switch_pending && scheduler_started)
+        switch_context();
+    sigprocmask(SIG_UNBLOCK, &tick_signal, NULL);
+}
+
+/**
+ * @brief Request a context switch. It takes place immediately when called from a
+ *        task with interrupts enabled, and is deferred otherwise.
+ * @param None
+ * @retval None
+ */
+void port_pend_switch(void) {
+    uint32_t state;
+
+    switch_pending = 1;
+    if (in_tick || !scheduler_started)
+        return;
+
+    state = port_enter_critical();
+    port_exit_critical(state); // switches if interrupts were enabled
+}
+
+/**
+ * @brief Check if the caller runs in a task, as opposed to the tick handler or
+ *        `main()` before the scheduler was launched.
+ * @param None
+ * @retval Non-zero if the caller runs in a task.
+ */
+uint8_t port_can_block(void) {
+    return scheduler_started && !in_tick;
+}
+
+/**
+ * @brief The entry point of every task, which runs its handler and exits the task
+ *        if the handler returns.
+ * @param None
+ * @retval None
+ */
+static void task_entry(void) {
+    user_tasks[current_task].task_handler();
+    task_exit();
+}
+
+/**
+ * @brief Create the context of a task on the stack that belongs to its slot. The
+ *        task starts with interrupts enabled.
+ * @param task The index of the task in `user_tasks`.
+ * @retval None
+ */
+void port_init_task_stack(uint16_t task) {
+    getcontext(&contexts[task]);
+    contexts[task].uc_stack.ss_sp = stacks[task];
+    contexts[task].uc_stack.ss_size = sizeof(stacks[task]);
+    contexts[task].uc_link = NULL;
+    sigemptyset(&contexts[task].uc_sigmask);
+    makecontext(&contexts[task], task_entry, 0);
+}
+
+/**
+ * @brief Read a free running timestamp in nanoseconds from the monotonic clock.
+ * @param None
+ * @retval The current timestamp in nanoseconds.
+ */
+uint32_t read_timestamp(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec);
+}
+
+/**
+ * @brief The tick "interrupt" lets the kernel update the tick count and unblock
+ *        tasks, then performs the context switch the kernel requested.
+ * @param signal The signal number, always `SIGALRM`.
+ * @retval None
+ */
+static void tick_handler(int signal) {
+    (void)signal;
+
+    in_tick = 1;
+    sched_tick();
+    in_tick = 0;
+
+    if (switch_pending)
+        switch_context();
+}
+
+/**
+ * @brief Install the tick handler, start the interval timer and switch to the
+ *        current task. The context of `main()` is abandoned.
+ * @param tick_period The time between ticks in nanoseconds.
+ * @retval None
+ */
+void port_start_scheduler(uint32_t tick_period) {
+    struct sigaction action = {.sa_handler = tick_handler, .sa_flags = SA_RESTART};
+    struct itimerval timer = {
+        .it_interval = {.tv_sec = tick_period / 1000000000U, .tv_usec = (tick_period % 1000000000U) / 1000U},
+    };
+
+    sigprocmask(SIG_BLOCK, &tick_signal, NULL); // the first task unblocks it
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGALRM, &action, NULL);
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    scheduler_started = 1;
+    switch_pending = 0;
+    setcontext(&contexts[current_task]);
+    abort(); // setcontext() only returns on error
+}
+
+/**
+ * @brief Prepare the signal set used to mask the tick before any task is created.
+ * @param None
+ * @retval None
+ */
+__attribute__((constructor)) static void init_tick_signal(void) {
+    sigemptyset(&tick_signal);
+    sigaddset(&tick_signal, SIGALRM);
+}
@@ -0,0 +1,39 @@
+/**
+ ********************************************************
+ * @file    Port/posix/portmacro.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the configuration of the
+ *          POSIX host port, which runs the kernel and its
+ *          tasks as a single Linux process. Tasks are
+ *          `ucontext` coroutines and the tick is a
+ *          `SIGALRM` signal, which is masked to disable
+ *          interrupts.
+ ********************************************************
+ */
+
+#ifndef __PORTMACRO_H__
+#define __PORTMACRO_H__
+
+#include <stdint.h>
+#include <unistd.h>
+
+#define PORT_POSIX
+
+#define KiB 1024U
+
+#define TICK_HZ_MS 1000000U // timestamps are in nanoseconds, so this is a 1 ms tick
+
+#define SIZE_TASK_STACK (64 * KiB) // glibc's stdio needs much more stack than newlib
+
+/**
+ * @brief Called by the idle task in a loop; sleeps until the next tick instead of
+ *        spinning, so the process does not use a whole CPU.
+ * @param None
+ * @retval None
+ */
+static inline void port_idle(void) {
+    pause();
+}
+
+#endif // __PORTMACRO_H__
@@ -0,0 +1,85 @@
+/**
+ ********************************************************
+ * @file    Port/sim/port.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the simulator port of the
+ *          kernel. There are no interrupts to mask and no
+ *          contexts to switch: a requested context switch
+ *          is only recorded, and the simulator calls
+ *          `sched_switch_context()` itself. Time is the
+ *          virtual time of the simulation.
+ ********************************************************
+ */
+
+#include "port.h"
+#include "scheduler.h"
+#include <stdint.h>
+
+uint64_t sim_now = 0;           // virtual time in microseconds
+uint8_t sim_switch_pending = 0; // set when the kernel requests a context switch
+
+/**
+ * @brief There are no interrupts in the simulation.
+ * @param None
+ * @retval Always 0.
+ */
+uint32_t port_enter_critical(void) {
+    return 0;
+}
+
+/**
+ * @brief There are no interrupts in the simulation.
+ * @param state Ignored.
+ * @retval None
+ */
+void port_exit_critical(uint32_t state) {
+    (void)state;
+}
+
+/**
+ * @brief Record that the kernel requested a context switch.
+ * @param None
+ * @retval None
+ */
+void port_pend_switch(void) {
+    sim_switch_pending = 1;
+}
+
+/**
+ * @brief The simulator only calls blocking functions on behalf of the running task.
+ * @param None
+ * @retval Always 1.
+ */
+uint8_t port_can_block(void) {
+    return 1;
+}
+
+/**
+ * @brief Simulated tasks have no context.
+ * @param task The index of the task in `user_tasks`.
+ * @retval None
+ */
+void port_init_task_stack(uint16_t task) {
+    (void)task;
+}
+
+/**
+ * @brief Read the virtual time.
+ * @param None
+ * @retval The virtual time in microseconds.
+ */
+uint32_t read_timestamp(void) {
+    return (uint32_t)sim_now;
+}
+
+/**
+ * @brief Run the simulation. Unlike on the other ports, `launch_scheduler()` returns
+ *        once the simulation is over.
+ * @param tick_period The time between ticks in microseconds.
+ * @retval None
+ */
+void port_start_scheduler(uint32_t tick_period) {
+    sim_switch_pending = 0;
+    sim_run(tick_period);
+}
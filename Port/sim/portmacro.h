@@ -0,0 +1,37 @@
+/**
+ ********************************************************
+ * @file    Port/sim/portmacro.h
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file provides the configuration of the
+ *          simulator port, which links the kernel against
+ *          virtual time instead of hardware. Tasks are not
+ *          executed; the simulator in `Sim/` models their
+ *          execution and calls the kernel on their behalf.
+ ********************************************************
+ */
+
+#ifndef __PORTMACRO_H__
+#define __PORTMACRO_H__
+
+#include <stdint.h>
+
+#define PORT_SIM
+
+#define TICK_HZ_MS 1000U // virtual timestamps are in microseconds, so this is a 1 ms tick
+
+extern uint64_t sim_now;
+extern uint8_t sim_switch_pending;
+
+void sim_run(uint32_t tick_period);
+
+/**
+ * @brief Called by the idle task in a loop; the idle task is never executed by the
+ *        simulator.
+ * @param None
+ * @retval None
+ */
+static inline void port_idle(void) {
+}
+
+#endif // __PORTMACRO_H__
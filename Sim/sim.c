@@ -0,0 +1,616 @@
+/**
+ ********************************************************
+ * @file    Sim/sim.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains a discrete-event scheduling
+ *          simulator. It links the kernel's own scheduling
+ *          policy against virtual time, models periodic
+ *          tasks described by a workload file, and reports
+ *          response time distributions, deadline misses,
+ *          context switches and idle time. Time only
+ *          advances tick by tick while a task runs; idle
+ *          stretches are skipped up to the next wake up.
+ ********************************************************
+ */
+
+#include "port.h"
+#include "scheduler.h"
+#include "tasks.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SIM_MAX_GROUPS 64U
+#define SIM_NAME_LENGTH 32U
+#define SIM_SUB_BUCKETS 16U // sub-buckets per power of 2 of a response time histogram (6% resolution)
+#define SIM_BUCKETS (30U * SIM_SUB_BUCKETS)
+#define SIM_OFFSET_RANDOM 0xFFFFFFFFU
+
+/**
+ * @brief A group of identical periodic tasks read from the
+ *        workload file, with their response time histogram
+ */
+typedef struct SimGroup {
+    char name[SIM_NAME_LENGTH];     /**< The name of the group */
+    uint32_t count;                 /**< The number of tasks in the group */
+    uint32_t period;                /**< The period and relative deadline in ticks */
+    uint32_t exec_min;              /**< The shortest execution time of a job in microseconds */
+    uint32_t exec_max;              /**< The longest execution time of a job in microseconds */
+    uint8_t priority;               /**< The priority of the tasks */
+    uint32_t block_after;           /**< Execution time in microseconds after which a job blocks, or 0 */
+    uint32_t block;                 /**< The number of ticks a job blocks for */
+    uint32_t offset;                /**< The tick of the first release, or `SIM_OFFSET_RANDOM` */
+    uint32_t slice;                 /**< The time slice of the tasks in ticks, or 0 for the default */
+    uint32_t budget;                /**< The CPU budget of every task in microseconds, or 0 for none */
+    uint32_t budget_period;         /**< The replenishment period of the budget in ticks */
+    uint64_t jobs;                  /**< The number of completed jobs */
+    uint64_t misses;                /**< The number of jobs completed after their deadline */
+    uint64_t total;                 /**< The sum of all response times in microseconds */
+    uint64_t max;                   /**< The longest response time in microseconds */
+    uint64_t buckets[SIM_BUCKETS];  /**< Log-linear histogram of the response times */
+} SimGroup_Type;
+
+/**
+ * @brief The state of the job a simulated task is executing
+ */
+typedef struct SimTask {
+    SimGroup_Type *group;  /**< The group the task belongs to */
+    uint64_t release_tick; /**< The tick the current job was released at */
+    uint32_t executed;     /**< Execution time of the current job so far in microseconds */
+    uint32_t exec;         /**< Total execution time of the current job in microseconds */
+    uint8_t blocked;       /**< Non-zero once the current job has blocked */
+} SimTask_Type;
+
+/**
+ * @brief A pending wake up of a blocked task, kept in a
+ *        binary min-heap to find the end of idle stretches
+ */
+typedef struct SimWake {
+    uint64_t tick;  /**< The tick the task is woken at */
+    uint16_t task;  /**< The index of the task in `user_tasks` */
+} SimWake_Type;
+
+static SimGroup_Type groups[SIM_MAX_GROUPS];
+static uint32_t group_count = 0;
+static SimTask_Type sim_tasks[MAX_TASKS];
+static SimWake_Type wake_heap[MAX_TASKS];
+static uint32_t wake_count = 0;
+static uint64_t ticks = 0;        // 64-bit tick count, `g_tick_count` is its low half
+static uint64_t duration = 0;     // the virtual time to simulate in microseconds
+static uint64_t switches = 0;     // the number of context switches to a different task
+static uint64_t pendsv_count = 0; // the number of times the kernel was asked to switch context
+static uint64_t random_state = 1;
+static uint8_t check_heap = 0;    // check the ready heap after every tick, with `SCHED_EDF`
+
+/**
+ * @brief The idle task is never executed by the simulator.
+ * @param None
+ * @retval None
+ */
+void idle_task(void) {
+}
+
+/**
+ * @brief Simulated tasks are never executed; their behaviour is modelled by the
+ *        simulator.
+ * @param None
+ * @retval None
+ */
+static void sim_task(void) {
+}
+
+/**
+ * @brief Draw a pseudo random number with xorshift64.
+ * @param None
+ * @retval A pseudo random 64-bit number.
+ */
+static uint64_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/**
+ * @brief Draw a value uniformly distributed in a range.
+ * @param min The smallest value.
+ * @param max The largest value.
+ * @retval The value.
+ */
+static uint32_t random_between(uint32_t min, uint32_t max) {
+    return min + (uint32_t)(next_random() % ((uint64_t)max - min + 1));
+}
+
+/**
+ * @brief Add a wake up to the heap.
+ * @param tick The tick the task is woken at.
+ * @param task The index of the task in `user_tasks`.
+ * @retval None
+ */
+static void push_wake(uint64_t tick, uint16_t task) {
+    uint32_t i = wake_count++;
+
+    while (i && (wake_heap[(i - 1) / 2].tick > tick)) {
+        wake_heap[i] = wake_heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    wake_heap[i] = (SimWake_Type){.tick = tick, .task = task};
+}
+
+/**
+ * @brief Remove the earliest wake up from the heap.
+ * @param None
+ * @retval None
+ */
+static void pop_wake(void) {
+    SimWake_Type last = wake_heap[--wake_count];
+    uint32_t i = 0;
+
+    while ((2 * i) + 1 < wake_count) {
+        uint32_t child = (2 * i) + 1;
+        if ((child + 1 < wake_count) && (wake_heap[child + 1].tick < wake_heap[child].tick))
+            child++;
+        if (last.tick <= wake_heap[child].tick)
+            break;
+        wake_heap[i] = wake_heap[child];
+        i = child;
+    }
+    wake_heap[i] = last;
+}
+
+/**
+ * @brief Get the histogram bucket of a response time. Values below 16 have their own
+ *        bucket; larger values are split into 16 buckets per power of 2.
+ * @param value The response time in microseconds.
+ * @retval The bucket index.
+ */
+static uint32_t bucket_of(uint64_t value) {
+    uint32_t exponent;
+
+    if (value < SIM_SUB_BUCKETS)
+        return (uint32_t)value;
+    if (value > UINT32_MAX)
+        value = UINT32_MAX;
+
+    exponent = 31 - (uint32_t)__builtin_clz((uint32_t)value); // at least 4
+    return ((exponent - 3) * SIM_SUB_BUCKETS) + (uint32_t)((value >> (exponent - 4)) & (SIM_SUB_BUCKETS - 1));
+}
+
+/**
+ * @brief Get the smallest response time counted in a bucket.
+ * @param bucket The bucket index.
+ * @retval The lower bound of the bucket in microseconds.
+ */
+static uint64_t bucket_start(uint32_t bucket) {
+    uint32_t exponent = (bucket / SIM_SUB_BUCKETS) + 3;
+
+    if (bucket < SIM_SUB_BUCKETS)
+        return bucket;
+    return (uint64_t)(SIM_SUB_BUCKETS + (bucket % SIM_SUB_BUCKETS)) << (exponent - 4);
+}
+
+/**
+ * @brief Find a percentile of the response times of a group.
+ * @param group The task group.
+ * @param per_mille The percentile in tenths of a percent.
+ * @retval The upper bound of the bucket the percentile falls into, capped at the maximum.
+ */
+static uint64_t percentile(const SimGroup_Type *group, uint32_t per_mille) {
+    uint64_t rank = ((group->jobs * per_mille) + 999) / 1000;
+    uint64_t seen = 0;
+
+    for (uint32_t i = 0; i < SIM_BUCKETS; ++i) {
+        seen += group->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = bucket_start(i + 1) - 1;
+            return (upper < group->max) ? upper : group->max;
+        }
+    }
+
+    return group->max;
+}
+
+/**
+ * @brief Start a new job of a task.
+ * @param task The index of the task in `user_tasks`.
+ * @param release_tick The tick the job is released at.
+ * @retval None
+ */
+static void release_job(uint16_t task, uint64_t release_tick) {
+    SimTask_Type *sim_task_state = &sim_tasks[task];
+    SimGroup_Type *group = sim_task_state->group;
+
+    sim_task_state->release_tick = release_tick;
+    sim_task_state->executed = 0;
+    sim_task_state->exec = random_between(group->exec_min, group->exec_max);
+    sim_task_state->blocked = 0;
+}
+
+/**
+ * @brief Block the running task with the kernel's `task_delay()` and remember when
+ *        it wakes up.
+ * @param delay The number of ticks to block for.
+ * @retval None
+ */
+static void block_current_task(uint32_t delay) {
+    task_delay(delay);
+    push_wake(ticks + delay, current_task);
+}
+
+/**
+ * @brief Remember when a task throttled by the kernel gets its CPU budget back, so
+ *        idle time is not skipped past it.
+ * @param task The index of the throttled task in `user_tasks`.
+ * @retval None
+ */
+static void wait_for_budget(uint16_t task) {
+    push_wake(ticks + (uint32_t)(user_tasks[task].replenish_tick - g_tick_count), task);
+}
+
+/**
+ * @brief Called when the running task has executed as far as it can without
+ *        blocking: either up to the point where its job blocks, or to the end of
+ *        its job. A completed job is recorded and the task sleeps until its next
+ *        release, unless that release is already due.
+ * @param tick_period The time between ticks in microseconds.
+ * @retval None
+ */
+static void end_of_segment(uint32_t tick_period) {
+    SimTask_Type *task = &sim_tasks[current_task];
+    SimGroup_Type *group = task->group;
+    uint64_t response;
+    uint64_t next_release;
+
+    if (group->block && !task->blocked && (task->executed < task->exec)) {
+        // a block within the job, e.g. on I/O, waits on an object so the job keeps its deadline
+        task->blocked = 1;
+        task_wait(task, 0, group->block);
+        push_wake(ticks + group->block, current_task);
+        return;
+    }
+
+    response = sim_now - (task->release_tick * tick_period);
+    group->jobs++;
+    group->total += response;
+    group->buckets[bucket_of(response)]++;
+    if (response > group->max)
+        group->max = response;
+    if (response > ((uint64_t)group->period * tick_period))
+        group->misses++;
+
+    next_release = task->release_tick + group->period;
+    release_job(current_task, next_release);
+    if (next_release > ticks)
+        block_current_task((uint32_t)(next_release - ticks));
+}
+
+/**
+ * @brief Let the kernel choose the next task if a context switch was requested.
+ * @param None
+ * @retval None
+ */
+static void switch_if_pending(void) {
+    uint16_t previous = current_task;
+
+    if (!sim_switch_pending)
+        return;
+
+    sim_switch_pending = 0;
+    pendsv_count++;
+    sched_switch_context();
+    if (current_task != previous)
+        switches++;
+}
+
+/**
+ * @brief Run the simulation until `duration` has passed. Called by the simulator port
+ *        from `launch_scheduler()`.
+ * @param tick_period The time between ticks in microseconds.
+ * @retval None
+ */
+void sim_run(uint32_t tick_period) {
+    while (sim_now < duration) {
+        uint64_t next_tick = (ticks + 1) * tick_period;
+
+        if (current_task == 0) {
+            // nothing is READY: skip ahead to the tick at which the next task wakes up
+            if (!wake_count)
+                break;
+            if (wake_heap[0].tick > ticks + 1) {
+                g_tick_count += (uint32_t)(wake_heap[0].tick - ticks - 1);
+                ticks = wake_heap[0].tick - 1;
+                next_tick = (ticks + 1) * tick_period;
+            }
+            sim_now = next_tick;
+        } else {
+            SimTask_Type *task = &sim_tasks[current_task];
+            uint32_t segment = (task->group->block && !task->blocked) ? task->group->block_after : task->exec;
+            uint64_t run;
+
+            if (task->release_tick > ticks) {
+                // the first job is released after an offset, which the task waits for
+                block_current_task((uint32_t)(task->release_tick - ticks));
+                switch_if_pending();
+                continue;
+            }
+            if (segment > task->exec)
+                segment = task->exec;
+            run = segment - task->executed;
+            if (run > next_tick - sim_now)
+                run = next_tick - sim_now;
+
+            sim_now += run;
+            task->executed += (uint32_t)run;
+            if (task->executed == segment) {
+                end_of_segment(tick_period);
+                switch_if_pending();
+            }
+        }
+
+        if (sim_now == next_tick) {
+            uint16_t running = current_task;
+
+            ticks++;
+            sched_tick();
+#ifdef SCHED_EDF
+            if (check_heap && !sched_check_ready_heap()) {
+                fprintf(stderr, "ready heap inconsistent after tick %" PRIu64 "\n", ticks);
+                exit(1);
+            }
+#endif
+            if (user_tasks[running].current_state == THROTTLED)
+                wait_for_budget(running);
+            while (wake_count && (wake_heap[0].tick <= ticks)) {
+                uint16_t task = wake_heap[0].task;
+
+                pop_wake(); // woken by the tick
+                if (user_tasks[task].current_state == THROTTLED)
+                    wait_for_budget(task); // the budget did not cover an overrun
+            }
+            switch_if_pending();
+        }
+    }
+
+    update_run_time(); // charge the running task up to the end of the simulation
+}
+
+/**
+ * @brief Parse an unsigned number and advance past it.
+ * @param p_text The text to parse, advanced past the number.
+ * @param p_value The parsed value.
+ * @retval Non-zero if a number was parsed.
+ */
+static int parse_number(const char **p_text, uint32_t *p_value) {
+    char *end;
+    unsigned long value = strtoul(*p_text, &end, 10);
+
+    if (end == *p_text)
+        return 0;
+    *p_value = (uint32_t)value;
+    *p_text = end;
+    return 1;
+}
+
+/**
+ * @brief Parse a `key=value` attribute of a task group.
+ * @param group The task group to update.
+ * @param attribute The attribute text.
+ * @retval Non-zero if the attribute is valid.
+ */
+static int parse_attribute(SimGroup_Type *group, const char *attribute) {
+    const char *value = strchr(attribute, '=');
+    uint32_t priority;
+
+    if (!value)
+        return 0;
+    value++;
+
+    if (!strncmp(attribute, "count=", 6))
+        return parse_number(&value, &group->count) && !*value;
+    if (!strncmp(attribute, "period=", 7))
+        return parse_number(&value, &group->period) && !*value;
+    if (!strncmp(attribute, "exec=", 5)) {
+        if (!parse_number(&value, &group->exec_min))
+            return 0;
+        group->exec_max = group->exec_min;
+        if (*value == '-') {
+            value++;
+            if (!parse_number(&value, &group->exec_max))
+                return 0;
+        }
+        return !*value && (group->exec_max >= group->exec_min);
+    }
+    if (!strncmp(attribute, "priority=", 9)) {
+        if (!parse_number(&value, &priority) || *value || (priority <= IDLE_TASK_PRIORITY) || (priority > 255))
+            return 0;
+        group->priority = (uint8_t)priority;
+        return 1;
+    }
+    if (!strncmp(attribute, "block_after=", 12))
+        return parse_number(&value, &group->block_after) && !*value;
+    if (!strncmp(attribute, "block=", 6))
+        return parse_number(&value, &group->block) && !*value;
+    if (!strncmp(attribute, "budget=", 7))
+        return parse_number(&value, &group->budget) && !*value && (group->budget <= INT32_MAX);
+    if (!strncmp(attribute, "budget_period=", 14))
+        return parse_number(&value, &group->budget_period) && !*value && group->budget_period;
+    if (!strncmp(attribute, "slice=", 6))
+        return parse_number(&value, &group->slice) && !*value && (group->slice <= UINT16_MAX);
+    if (!strncmp(attribute, "offset=", 7)) {
+        if (!strcmp(value, "random")) {
+            group->offset = SIM_OFFSET_RANDOM;
+            return 1;
+        }
+        return parse_number(&value, &group->offset) && !*value;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Read the task groups of a workload file. Every line describes a group as
+ *        its name followed by `key=value` attributes; `#` starts a comment.
+ * @param path The path of the workload file.
+ * @retval Non-zero if the workload is valid.
+ */
+static int read_workload(const char *path) {
+    char line[256];
+    uint32_t line_number = 0;
+    uint32_t tasks = 0;
+    FILE *file = fopen(path, "r");
+
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), file)) {
+        SimGroup_Type *group = &groups[group_count];
+        char *token;
+
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+        token = strtok(line, " \t");
+        if (!token)
+            continue;
+
+        if (group_count == SIM_MAX_GROUPS) {
+            fprintf(stderr, "%s:%" PRIu32 ": too many task groups\n", path, line_number);
+            fclose(file);
+            return 0;
+        }
+
+        *group = (SimGroup_Type){.count = 1, .priority = DEFAULT_TASK_PRIORITY, .offset = SIM_OFFSET_RANDOM};
+        snprintf(group->name, sizeof(group->name), "%s", token);
+        while ((token = strtok(NULL, " \t")) != NULL) {
+            if (!parse_attribute(group, token)) {
+                fprintf(stderr, "%s:%" PRIu32 ": invalid attribute '%s'\n", path, line_number, token);
+                fclose(file);
+                return 0;
+            }
+        }
+
+        if (!group->period || !group->exec_max) {
+            fprintf(stderr, "%s:%" PRIu32 ": period and exec are required\n", path, line_number);
+            fclose(file);
+            return 0;
+        }
+        if (group->budget && !group->budget_period)
+            group->budget_period = group->period;
+
+        tasks += group->count;
+        group_count++;
+    }
+
+    fclose(file);
+    if (tasks > MAX_TASKS - 1) {
+        fprintf(stderr, "%s: %" PRIu32 " tasks, but at most %u can be created\n", path, tasks, MAX_TASKS - 1);
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Create the tasks of all groups with the kernel's `task_create()` and choose
+ *        the release tick of their first job.
+ * @param None
+ * @retval None
+ */
+static void create_tasks(void) {
+    for (uint32_t g = 0; g < group_count; ++g) {
+        for (uint32_t i = 0; i < groups[g].count; ++i) {
+            uint16_t task = task_create(sim_task, groups[g].priority);
+            uint32_t offset = groups[g].offset;
+
+            if (offset == SIM_OFFSET_RANDOM)
+                offset = random_between(0, groups[g].period - 1);
+
+            sim_tasks[task].group = &groups[g];
+            task_set_deadline(task, groups[g].period);
+            task_set_time_slice(task, (uint16_t)groups[g].slice);
+            if (groups[g].budget)
+                task_set_budget(task, groups[g].budget * (TICK_HZ_MS / 1000U), groups[g].budget_period);
+            release_job(task, offset); // the task delays itself until then when it first runs
+        }
+    }
+}
+
+/**
+ * @brief Print the results of the simulation.
+ * @param wall_time The time the simulation took in seconds.
+ * @retval None
+ */
+static void print_report(double wall_time) {
+    double seconds = (double)sim_now / 1e6;
+    double idle = 100.0 * (double)user_tasks[0].run_time / (double)(sim_now ? sim_now : 1);
+
+    printf(
+        "simulated %.3f s in %.3f s (%.0fx real time), %" PRIu64 " ticks\n", seconds, wall_time,
+        seconds / (wall_time > 0 ? wall_time : 1e-9), ticks
+    );
+    printf(
+        "context switches %" PRIu64 " (%.1f/s), PendSV %.1f/s, idle %.2f%%\n", switches, switches / seconds,
+        pendsv_count / seconds, idle
+    );
+#ifdef SCHED_EDF
+    printf("policy: earliest deadline first\n\n");
+#else
+    printf("policy: round robin\n\n");
+#endif
+
+    printf("%-16s %6s %6s %5s %10s %10s %10s %10s %10s %10s %10s\n", "group", "tasks", "prio", "jobs/1k", "misses",
+           "avg_us", "p50_us", "p90_us", "p99_us", "p99.9_us", "max_us");
+    for (uint32_t g = 0; g < group_count; ++g) {
+        const SimGroup_Type *group = &groups[g];
+
+        printf(
+            "%-16s %6" PRIu32 " %6u %7" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64
+            " %10" PRIu64 " %10" PRIu64 "\n",
+            group->name, group->count, group->priority, group->jobs / 1000, group->misses,
+            group->jobs ? group->total / group->jobs : 0, percentile(group, 500), percentile(group, 900),
+            percentile(group, 990), percentile(group, 999), group->max
+        );
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *workload = NULL;
+    double seconds = 3600.0;
+    struct timespec start;
+    struct timespec end;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--duration") && (i + 1 < argc))
+            seconds = strtod(argv[++i], NULL);
+        else if (!strcmp(argv[i], "--seed") && (i + 1 < argc))
+            random_state = strtoull(argv[++i], NULL, 0) | 1;
+        else if (!strcmp(argv[i], "--check"))
+            check_heap = 1;
+        else if (!workload && (argv[i][0] != '-'))
+            workload = argv[i];
+        else
+            workload = NULL;
+    }
+
+    if (!workload) {
+        fprintf(stderr, "usage: %s <workload> [--duration seconds] [--seed n] [--check]\n", argv[0]);
+        return 2;
+    }
+    if (!read_workload(workload))
+        return 1;
+
+    duration = (uint64_t)(seconds * 1e6);
+    create_tasks();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    launch_scheduler(TICK_HZ_MS);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    print_report((double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9));
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ ********************************************************
+ * @file    Src/active_object.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          starting active objects, posting events to
+ *          them and the task which dispatches the events
+ *          of all active objects of one priority.
+ ********************************************************
+ */
+
+#include "active_object.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The active objects of one priority and the task which runs them.
+ */
+typedef struct ActiveGroup {
+    uint16_t task;              // index of the task in `user_tasks`, or 0 if the group is unused
+    uint8_t priority;           // priority of the task and of every object in the group
+    uint32_t pending;           // the number of events queued to all objects of the group
+    ActiveObject_Type *objects; // the objects of the group
+    ActiveObject_Type *cursor;  // the object an event was last dispatched to
+} ActiveGroup_Type;
+
+static ActiveGroup_Type groups[ACTIVE_OBJECT_MAX_GROUPS];
+
+/**
+ * @brief Initialize an active object. The object does not receive events until
+ *        it is started.
+ * @param object The active object to initialize.
+ * @param dispatch The function called for every event posted to the object.
+ * @param context User data available to the dispatch function through `object->context`.
+ * @param queue Storage for the pointers to the events waiting to be dispatched.
+ * @param queue_size The number of events `queue` can hold.
+ * @retval None
+ */
+void active_object_init(
+    ActiveObject_Type *object, void (*dispatch)(ActiveObject_Type *object, const Event_Type *event), void *context,
+    const Event_Type **queue, uint8_t queue_size
+) {
+    *object = (ActiveObject_Type){.dispatch = dispatch, .context = context, .queue = queue, .queue_size = queue_size};
+}
+
+/**
+ * @brief Get the next active object of a group with an event to dispatch,
+ *        starting after the one dispatched last so the objects of a priority
+ *        take turns. Must be called with interrupts disabled and events pending.
+ * @param group The group to search.
+ * @retval The active object to dispatch an event to.
+ */
+static ActiveObject_Type *next_object(ActiveGroup_Type *group) {
+    ActiveObject_Type *object = group->cursor;
+
+    do {
+        object = ((object == NULL) || (object->next == NULL)) ? group->objects : object->next;
+    } while (object->count == 0);
+
+    group->cursor = object;
+    return object;
+}
+
+/**
+ * @brief The task shared by all active objects of one priority. It dispatches
+ *        one event at a time, taking turns between the objects with pending
+ *        events, and blocks while no object has an event.
+ * @param None
+ * @retval None
+ */
+static void active_object_task(void) {
+    ActiveGroup_Type *group = NULL;
+
+    for (size_t i = 0; i < ACTIVE_OBJECT_MAX_GROUPS; ++i)
+        if (groups[i].task == current_task)
+            group = &groups[i];
+
+    while (1) {
+        uint32_t primask = enter_critical();
+
+        user_tasks[current_task].wait_object = NULL;
+
+        if (group->pending == 0) {
+            task_wait(group, 0, WAIT_FOREVER);
+            exit_critical(primask);
+            continue;
+        }
+
+        ActiveObject_Type *object = next_object(group);
+        const Event_Type *event = object->queue[object->tail];
+        object->tail = (object->tail + 1) % object->queue_size;
+        object->count--;
+        group->pending--;
+
+        exit_critical(primask);
+
+        object->dispatch(object, event);
+    }
+}
+
+/**
+ * @brief Start an active object at a priority. The first object of a priority
+ *        creates the task that all objects of the priority share.
+ * @param object The active object to start; it must not be started already.
+ * @param priority The priority of the task which dispatches the object's events.
+ * @retval 1 on success, 0 if no task could be created for a new priority.
+ */
+uint8_t active_object_start(ActiveObject_Type *object, uint8_t priority) {
+    uint32_t primask = enter_critical();
+    ActiveGroup_Type *group = NULL;
+
+    for (size_t i = 0; (i < ACTIVE_OBJECT_MAX_GROUPS) && (group == NULL); ++i)
+        if (groups[i].task && (groups[i].priority == priority))
+            group = &groups[i];
+
+    for (size_t i = 0; (i < ACTIVE_OBJECT_MAX_GROUPS) && (group == NULL); ++i) {
+        if (groups[i].task == 0) {
+            // the group is filled in before the task can run, since interrupts are disabled
+            groups[i].task = task_create(active_object_task, priority);
+            if (groups[i].task == 0)
+                break;
+            groups[i].priority = priority;
+            group = &groups[i];
+        }
+    }
+
+    if (group != NULL) {
+        object->group = group;
+        object->next = group->objects;
+        group->objects = object;
+    }
+
+    exit_critical(primask);
+    return group != NULL;
+}
+
+/**
+ * @brief Post an event to an active object in constant time, without copying
+ *        it, and wake the task of its priority. This function may be called
+ *        from interrupt service routines, tasks and other active objects.
+ * @param object The active object to post the event to.
+ * @param event The event, which must stay valid until it is dispatched.
+ * @retval 1 if the event was queued, 0 if the queue is full or the object was not started.
+ */
+uint8_t active_object_post(ActiveObject_Type *object, const Event_Type *event) {
+    uint32_t primask = enter_critical();
+    ActiveGroup_Type *group = object->group;
+    uint8_t queued = 0;
+
+    if (object->count == object->queue_size) {
+        object->dropped++;
+    } else if (group != NULL) {
+        object->queue[object->head] = event;
+        object->head = (object->head + 1) % object->queue_size;
+        if (++object->count > object->max_count)
+            object->max_count = object->count;
+        group->pending++;
+        queued = 1;
+
+        if ((user_tasks[group->task].current_state != READY) && (user_tasks[group->task].wait_object == group))
+            task_wake(group->task);
+    }
+
+    exit_critical(primask);
+    return queued;
+}
@@ -0,0 +1,182 @@
+/**
+ ********************************************************
+ * @file    Src/coroutine.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          starting and notifying stackless coroutines
+ *          and the coroutine task which runs them one
+ *          after another on its own stack.
+ ********************************************************
+ */
+
+#include "coroutine.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static Coroutine_Type *ready_head = NULL;   // READY coroutines in the order they run
+static Coroutine_Type *ready_tail = NULL;   // last READY coroutine, to append in constant time
+static Coroutine_Type *delayed_list = NULL; // DELAYED coroutines sorted by wake tick
+static Coroutine_Type *waiting_list = NULL; // WAITING coroutines, checked again after a notification
+static volatile uint8_t notified = 0;       // set by `coroutine_notify()` until the waiting list is checked
+static uint16_t coroutine_task_index = 0;   // index of the coroutine task in `user_tasks`
+
+/**
+ * @brief Check if a tick count has been reached, taking wrap around of the
+ *        global tick count into account.
+ * @param tick The tick count to compare against the global tick count.
+ * @retval Non-zero if `tick` is now or in the past.
+ */
+static int tick_reached(uint32_t tick) {
+    return (int32_t)(tick - g_tick_count) <= 0;
+}
+
+/**
+ * @brief Append a coroutine to the READY list. Must be called with interrupts disabled.
+ * @param co The coroutine to append.
+ * @retval None
+ */
+static void append_ready(Coroutine_Type *co) {
+    co->state = COROUTINE_READY;
+    co->next = NULL;
+
+    if (ready_tail != NULL)
+        ready_tail->next = co;
+    else
+        ready_head = co;
+    ready_tail = co;
+}
+
+/**
+ * @brief Insert a coroutine into the DELAYED list, keeping the list sorted by
+ *        wake tick. Must be called with interrupts disabled.
+ * @param co The coroutine to insert.
+ * @retval None
+ */
+static void insert_delayed(Coroutine_Type *co) {
+    Coroutine_Type **link = &delayed_list;
+
+    while ((*link != NULL) && ((int32_t)((*link)->wake_tick - co->wake_tick) <= 0))
+        link = &(*link)->next;
+
+    co->state = COROUTINE_DELAYED;
+    co->next = *link;
+    *link = co;
+}
+
+/**
+ * @brief Wake the coroutine task if it is sleeping, so it can run a coroutine
+ *        that became READY. Must be called with interrupts disabled.
+ * @param None
+ * @retval None
+ */
+static void notify_coroutine_task(void) {
+    if (coroutine_task_index && (user_tasks[coroutine_task_index].current_state != READY) &&
+        (user_tasks[coroutine_task_index].wait_object == &ready_head))
+        task_wake(coroutine_task_index);
+}
+
+/**
+ * @brief Start a coroutine from the top of its body. A coroutine may only be
+ *        started when it is not running, or after it is DONE. This function
+ *        may be called from an interrupt service routine.
+ * @param co The control block of the coroutine.
+ * @param body The body of the coroutine, written with the `CO_*` macros.
+ * @param context User data available to the body through `co->context`.
+ * @retval None
+ */
+void coroutine_start(Coroutine_Type *co, uint8_t (*body)(Coroutine_Type *co), void *context) {
+    uint32_t primask = enter_critical();
+
+    co->body = body;
+    co->context = context;
+    co->wake_tick = 0;
+    co->resume_line = 0;
+    append_ready(co);
+    notify_coroutine_task();
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief Signal that a condition a coroutine waits for with `CO_WAIT_UNTIL()`
+ *        may have changed, so the WAITING coroutines check their conditions
+ *        again. This function may be called from an interrupt service routine.
+ * @param None
+ * @retval None
+ */
+void coroutine_notify(void) {
+    uint32_t primask = enter_critical();
+
+    notified = 1;
+    notify_coroutine_task();
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief The coroutine task runs the READY coroutines one after another until
+ *        each of them waits, moves DELAYED coroutines back to the READY list
+ *        when their wake tick is reached, and moves all WAITING coroutines
+ *        back after a notification. When no coroutine is READY it blocks until
+ *        the first wake tick or the next notification, so it only runs when
+ *        there is work to do. Create it with `task_create()` at
+ *        `COROUTINE_TASK_PRIORITY`; all coroutines share its stack.
+ * @param None
+ * @retval None
+ */
+void coroutine_task(void) {
+    coroutine_task_index = current_task;
+
+    while (1) {
+        uint32_t primask = enter_critical();
+        Coroutine_Type *co;
+
+        user_tasks[current_task].wait_object = NULL;
+
+        while ((delayed_list != NULL) && tick_reached(delayed_list->wake_tick)) {
+            co = delayed_list;
+            delayed_list = co->next;
+            append_ready(co);
+        }
+
+        if (notified) {
+            notified = 0;
+            while (waiting_list != NULL) {
+                co = waiting_list;
+                waiting_list = co->next;
+                append_ready(co);
+            }
+        }
+
+        co = ready_head;
+        if (co == NULL) {
+            task_wait(&ready_head, 0, (delayed_list != NULL) ? (delayed_list->wake_tick - g_tick_count) : WAIT_FOREVER);
+            exit_critical(primask);
+            continue;
+        }
+
+        ready_head = co->next;
+        if (ready_head == NULL)
+            ready_tail = NULL;
+        exit_critical(primask);
+
+        uint8_t state = co->body(co);
+
+        primask = enter_critical();
+        if (state == COROUTINE_READY) {
+            append_ready(co);
+        } else if (state == COROUTINE_DELAYED) {
+            insert_delayed(co);
+        } else if (state == COROUTINE_WAITING) {
+            co->state = COROUTINE_WAITING;
+            co->next = waiting_list;
+            waiting_list = co;
+        } else {
+            co->state = COROUTINE_DONE;
+            co->next = NULL;
+        }
+        exit_critical(primask);
+    }
+}
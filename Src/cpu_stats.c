@@ -0,0 +1,103 @@
+/**
+ ********************************************************
+ * @file    Src/cpu_stats.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          turning the run time the scheduler accumulates
+ *          for every task into CPU usage percentages. All
+ *          percentages are in hundredths of a percent.
+ ********************************************************
+ */
+
+#include "cpu_stats.h"
+#include "scheduler.h"
+#include "timers.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static SoftTimer_Type stats_timer;
+static uint64_t window_run_time[MAX_TASKS];   // run time of every task at the start of the current window
+static uint16_t window_generation[MAX_TASKS]; // generation of every slot at the start of the current window
+static uint32_t window_start = 0;             // timestamp of the start of the current window
+static uint16_t task_usage[MAX_TASKS];        // CPU usage of every task over the last window
+static uint32_t load_average = 0;             // moving average of the load, scaled by 2^CPU_STATS_AVERAGE_SHIFT
+
+/**
+ * @brief Timer callback executed every `CPU_STATS_WINDOW` ticks which computes the
+ *        CPU usage of every task over the window that just ended and updates the
+ *        moving average of the load.
+ * @param timer The statistics timer.
+ * @retval None
+ */
+static void update_window(SoftTimer_Type *timer) {
+    (void)timer;
+    uint64_t run_time[MAX_TASKS];
+    uint32_t primask = enter_critical();
+
+    update_run_time(); // charge the running task up to now
+    uint32_t now = read_timestamp();
+    for (size_t i = 0; i < MAX_TASKS; ++i) {
+        run_time[i] = user_tasks[i].run_time;
+        if (user_tasks[i].generation != window_generation[i]) {
+            window_generation[i] = user_tasks[i].generation;
+            window_run_time[i] = 0; // the slot was reused, the new task started from 0
+        }
+    }
+
+    exit_critical(primask);
+
+    uint32_t elapsed = now - window_start;
+    window_start = now;
+    if (elapsed == 0)
+        return;
+
+    for (size_t i = 0; i < MAX_TASKS; ++i) {
+        uint64_t usage = ((run_time[i] - window_run_time[i]) * 10000U) / elapsed;
+        task_usage[i] = (usage > 10000U) ? 10000U : (uint16_t)usage; // the window may be shorter than run time
+        window_run_time[i] = run_time[i];
+    }
+
+    // exponential moving average: avg += (load - avg) / 2^shift, kept scaled by 2^shift
+    uint32_t load = 10000U - task_usage[0];
+    load_average += load - (load_average >> CPU_STATS_AVERAGE_SHIFT);
+}
+
+/**
+ * @brief Start measuring CPU usage. Must be called before the scheduler is launched.
+ * @param None
+ * @retval None
+ */
+void cpu_stats_init(void) {
+    window_start = read_timestamp();
+    timer_init(&stats_timer, update_window, NULL, CPU_STATS_WINDOW, TIMER_AUTO_RELOAD);
+    timer_start(&stats_timer);
+}
+
+/**
+ * @brief Get the CPU usage of a task over the last measurement window.
+ * @param task The index of the task in `user_tasks`.
+ * @retval The CPU usage in hundredths of a percent.
+ */
+uint16_t cpu_stats_task_usage(uint16_t task) {
+    return (task < MAX_TASKS) ? task_usage[task] : 0;
+}
+
+/**
+ * @brief Get the share of the last measurement window spent in the idle task.
+ * @param None
+ * @retval The idle time in hundredths of a percent.
+ */
+uint16_t cpu_stats_idle(void) {
+    return task_usage[0];
+}
+
+/**
+ * @brief Get the moving average of the system load, i.e. the CPU usage of all tasks
+ *        but the idle task, over the last measurement windows.
+ * @param None
+ * @retval The load average in hundredths of a percent.
+ */
+uint16_t cpu_stats_load_average(void) {
+    return (uint16_t)(load_average >> CPU_STATS_AVERAGE_SHIFT);
+}
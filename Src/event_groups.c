@@ -0,0 +1,148 @@
+/**
+ ********************************************************
+ * @file    Src/event_groups.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          setting, clearing and waiting on the bits of
+ *          an event group.
+ ********************************************************
+ */
+
+#include "event_groups.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Check if the bits currently set satisfy the bits a task is waiting for.
+ * @param current_bits The bits currently set in the event group.
+ * @param wait_bits The bits the task is waiting for.
+ * @param options `EVENT_WAIT_ALL` if all of `wait_bits` must be set.
+ * @retval Non-zero if the wait condition is satisfied.
+ */
+static int wait_condition_met(uint32_t current_bits, uint32_t wait_bits, uint32_t options) {
+    if (options & EVENT_WAIT_ALL)
+        return (current_bits & wait_bits) == wait_bits;
+
+    return (current_bits & wait_bits) != 0;
+}
+
+/**
+ * @brief Initialize an event group with all bits cleared.
+ * @param group The event group to initialize.
+ * @retval None
+ */
+void event_group_init(EventGroup_Type *group) {
+    group->bits = 0;
+}
+
+/**
+ * @brief Set bits in an event group and wake every task whose wait condition is
+ *        now satisfied. All waiters are checked in a single pass over the tasks and
+ *        at most one context switch is pended. Bits requested with `EVENT_CLEAR_ON_EXIT`
+ *        by any woken task are cleared after all waiters have been evaluated. This
+ *        function may be called from an interrupt service routine.
+ * @param group The event group to modify.
+ * @param bits The bits to set.
+ * @retval The value of the event bits after waking the waiters.
+ */
+uint32_t event_group_set(EventGroup_Type *group, uint32_t bits) {
+    uint32_t primask = enter_critical();
+    uint32_t clear_bits = 0;
+    uint32_t result;
+
+    group->bits |= (bits & EVENT_BITS_MASK);
+
+    for (size_t i = 1; i < MAX_TASKS; ++i) {
+        if ((user_tasks[i].current_state == READY) || (user_tasks[i].wait_object != group))
+            continue;
+
+        uint32_t wait_bits = user_tasks[i].wait_value & EVENT_BITS_MASK;
+        uint32_t options = user_tasks[i].wait_value & ~EVENT_BITS_MASK;
+
+        if (wait_condition_met(group->bits, wait_bits, options)) {
+            if (options & EVENT_CLEAR_ON_EXIT)
+                clear_bits |= wait_bits;
+
+            // hand the bits that satisfied the wait back to the waiting task
+            task_wake(i);
+            user_tasks[i].wait_value = group->bits;
+        }
+    }
+
+    group->bits &= ~clear_bits;
+    result = group->bits;
+
+    exit_critical(primask);
+    return result;
+}
+
+/**
+ * @brief Clear bits in an event group. This function may be called from an
+ *        interrupt service routine.
+ * @param group The event group to modify.
+ * @param bits The bits to clear.
+ * @retval The value of the event bits before they were cleared.
+ */
+uint32_t event_group_clear(EventGroup_Type *group, uint32_t bits) {
+    uint32_t primask = enter_critical();
+    uint32_t previous = group->bits;
+
+    group->bits &= ~bits;
+
+    exit_critical(primask);
+    return previous;
+}
+
+/**
+ * @brief Get the bits currently set in an event group.
+ * @param group The event group to read.
+ * @retval The value of the event bits.
+ */
+uint32_t event_group_get(EventGroup_Type *group) {
+    return group->bits;
+}
+
+/**
+ * @brief Block the calling task until any, or all with `EVENT_WAIT_ALL`, of the
+ *        requested bits are set in the event group or the timeout expires. With
+ *        `EVENT_CLEAR_ON_EXIT` the requested bits are cleared when the wait is
+ *        satisfied. The caller can tell a timeout apart by checking the returned
+ *        bits against its wait condition. Outside a task, such as in an ISR, the
+ *        bits are only polled.
+ * @param group The event group to wait on.
+ * @param bits The bits to wait for.
+ * @param options Any combination of `EVENT_WAIT_ALL` and `EVENT_CLEAR_ON_EXIT`.
+ * @param tick_count Timeout in number of ticks, 0 to poll, or `WAIT_FOREVER`.
+ * @retval The value of the event bits when the wait was satisfied or timed out,
+ *         before any bits were cleared on exit.
+ */
+uint32_t event_group_wait(EventGroup_Type *group, uint32_t bits, uint32_t options, uint32_t tick_count) {
+    uint32_t primask = enter_critical();
+    uint32_t result = group->bits;
+
+    bits &= EVENT_BITS_MASK;
+    options &= ~EVENT_BITS_MASK;
+
+    if (wait_condition_met(result, bits, options)) {
+        if (options & EVENT_CLEAR_ON_EXIT)
+            group->bits &= ~bits;
+    } else if ((tick_count != 0) && task_can_block()) {
+        task_wait(group, bits | options, tick_count);
+        exit_critical(primask);
+
+        // the context switch to another task takes place here
+
+        primask = enter_critical();
+        if (user_tasks[current_task].wait_object == NULL) {
+            result = user_tasks[current_task].wait_value; // woken by event_group_set()
+        } else {
+            user_tasks[current_task].wait_object = NULL; // timed out
+            result = group->bits;
+        }
+    }
+
+    exit_critical(primask);
+    return result;
+}
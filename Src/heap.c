@@ -0,0 +1,460 @@
+/**
+ ********************************************************
+ * @file    Src/heap.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          the Two-Level Segregated Fit (TLSF) heap. Free
+ *          blocks are kept in lists by size class, found
+ *          through two levels of bitmaps, so allocating
+ *          and freeing take constant time. On the firmware
+ *          the heap backs newlib's malloc() family, over
+ *          the `._heap` region of the linker script.
+ ********************************************************
+ */
+
+#include "heap.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef PORT_NEWLIB_REENT
+#include <errno.h>
+#include <reent.h>
+#endif
+
+#define HEAP_ALIGN_LOG2 ((sizeof(void *) == 8) ? 4 : 3) // blocks are aligned to two pointers
+#define HEAP_ALIGN (1U << HEAP_ALIGN_LOG2)
+#define SL_COUNT (1U << HEAP_SL_LOG2)
+#define FL_SHIFT (HEAP_SL_LOG2 + HEAP_ALIGN_LOG2)
+#define SMALL_BLOCK (1U << FL_SHIFT) // blocks smaller than this are in first level 0, in evenly spaced lists
+#define FL_COUNT (HEAP_FL_MAX_LOG2 - FL_SHIFT + 1)
+#define BLOCK_HEADER offsetof(HeapBlock_Type, next_free)
+#define BLOCK_MIN_SIZE (sizeof(HeapBlock_Type) - BLOCK_HEADER)
+#define BLOCK_MAX_SIZE ((1U << HEAP_FL_MAX_LOG2) - HEAP_ALIGN)
+#define BLOCK_FREE 1U // flag in the size of a block, which is a multiple of `HEAP_ALIGN`
+
+/**
+ * @brief A block of the heap: a header followed by the memory handed out by
+ *        `heap_alloc()`. The links to other free blocks are only valid, and
+ *        only take up space, while the block is free.
+ */
+typedef struct HeapBlock {
+    struct HeapBlock *prev_physical; // the block before this one in memory, NULL for the first block
+    size_t size;                     // the size of the block after the header, or'ed with `BLOCK_FREE`
+    struct HeapBlock *next_free;     // the next block in the same free list
+    struct HeapBlock *prev_free;     // the previous block in the same free list
+} HeapBlock_Type;
+
+static HeapBlock_Type *free_lists[FL_COUNT][SL_COUNT]; // free blocks by size class
+static uint32_t fl_bitmap = 0;                         // bit n is set while a list of first level n is not empty
+static uint32_t sl_bitmap[FL_COUNT];                   // bit n is set while list n of a first level is not empty
+static HeapStats_Type stats = {0};
+
+/**
+ * @brief Get the size of a block after its header.
+ * @param block The block.
+ * @retval The size in bytes.
+ */
+static size_t block_size(const HeapBlock_Type *block) {
+    return block->size & ~(size_t)BLOCK_FREE;
+}
+
+/**
+ * @brief Get the block after a block in memory.
+ * @param block The block.
+ * @retval The next block; the last block of the heap is followed by a used block of size 0.
+ */
+static HeapBlock_Type *next_physical(const HeapBlock_Type *block) {
+    return (HeapBlock_Type *)((uintptr_t)block + BLOCK_HEADER + block_size(block));
+}
+
+/**
+ * @brief Get the index of the most significant bit that is set.
+ * @param value A non-zero value.
+ * @retval The index of the bit.
+ */
+static uint32_t highest_bit(uint32_t value) {
+    return 31U - (uint32_t)__builtin_clz(value);
+}
+
+/**
+ * @brief Get the free list of the size class a block size belongs to.
+ * @param size The size of the block.
+ * @param fl Pointer to where the first level index is stored.
+ * @param sl Pointer to where the second level index is stored.
+ * @retval None
+ */
+static void map_size(size_t size, uint32_t *fl, uint32_t *sl) {
+    if (size < SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (uint32_t)size >> HEAP_ALIGN_LOG2;
+    } else {
+        uint32_t bit = highest_bit((uint32_t)size);
+
+        *sl = ((uint32_t)size >> (bit - HEAP_SL_LOG2)) ^ SL_COUNT;
+        *fl = bit - FL_SHIFT + 1;
+    }
+}
+
+/**
+ * @brief Add a block to the free list of its size class and mark it as free.
+ * @param block The block.
+ * @retval None
+ */
+static void insert_free_block(HeapBlock_Type *block) {
+    uint32_t fl, sl;
+
+    map_size(block_size(block), &fl, &sl);
+    block->size |= BLOCK_FREE;
+    block->prev_free = NULL;
+    block->next_free = free_lists[fl][sl];
+    if (block->next_free != NULL)
+        block->next_free->prev_free = block;
+    free_lists[fl][sl] = block;
+
+    fl_bitmap |= 1U << fl;
+    sl_bitmap[fl] |= 1U << sl;
+    stats.free_blocks++;
+}
+
+/**
+ * @brief Remove a block from the free list of its size class and mark it as used.
+ * @param block The block.
+ * @retval None
+ */
+static void remove_free_block(HeapBlock_Type *block) {
+    uint32_t fl, sl;
+
+    map_size(block_size(block), &fl, &sl);
+    if (block->next_free != NULL)
+        block->next_free->prev_free = block->prev_free;
+    if (block->prev_free != NULL) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        free_lists[fl][sl] = block->next_free;
+        if (free_lists[fl][sl] == NULL) {
+            sl_bitmap[fl] &= ~(1U << sl);
+            if (sl_bitmap[fl] == 0)
+                fl_bitmap &= ~(1U << fl);
+        }
+    }
+    block->size &= ~(size_t)BLOCK_FREE;
+    stats.free_blocks--;
+}
+
+/**
+ * @brief Get the smallest block size of the size class a block size belongs to,
+ *        which is the largest size `take_free_block()` finds a block of that
+ *        size class for, once it rounded the size up.
+ * @param size The size of the block.
+ * @retval The smallest size of the size class.
+ */
+static size_t class_floor(size_t size) {
+    if (size < SMALL_BLOCK)
+        return size;
+    return size & ~(size_t)((1U << (highest_bit((uint32_t)size) - HEAP_SL_LOG2)) - 1);
+}
+
+/**
+ * @brief Take a free block of at least a size from the free lists. The size is
+ *        rounded up to the next size class, so that every block of the first
+ *        non-empty list at or above that class is large enough.
+ * @param size The size of the block, a multiple of `HEAP_ALIGN`.
+ * @retval The block, or NULL if no free block is large enough.
+ */
+static HeapBlock_Type *take_free_block(size_t size) {
+    uint32_t fl, sl, sl_map;
+
+    if (size >= SMALL_BLOCK)
+        size += (1U << (highest_bit((uint32_t)size) - HEAP_SL_LOG2)) - 1;
+    map_size(size, &fl, &sl);
+    if (fl >= FL_COUNT)
+        return NULL;
+
+    sl_map = sl_bitmap[fl] & (~0U << sl);
+    if (sl_map == 0) {
+        uint32_t fl_map = fl_bitmap & (~0U << (fl + 1));
+
+        if (fl_map == 0)
+            return NULL;
+        fl = (uint32_t)__builtin_ctz(fl_map);
+        sl_map = sl_bitmap[fl];
+    }
+    sl = (uint32_t)__builtin_ctz(sl_map);
+
+    HeapBlock_Type *block = free_lists[fl][sl];
+    remove_free_block(block);
+    return block;
+}
+
+/**
+ * @brief Shrink a used block to a size and return the rest to the free lists, if
+ *        the rest is large enough to be a block of its own.
+ * @param block The block.
+ * @param size The size the block is shrunk to, a multiple of `HEAP_ALIGN`.
+ * @retval None
+ */
+static void split_block(HeapBlock_Type *block, size_t size) {
+    size_t rest_size = block_size(block) - size;
+
+    if (rest_size < (BLOCK_HEADER + BLOCK_MIN_SIZE))
+        return;
+
+    HeapBlock_Type *rest = (HeapBlock_Type *)((uintptr_t)block + BLOCK_HEADER + size);
+    rest->size = rest_size - BLOCK_HEADER;
+    rest->prev_physical = block;
+    next_physical(rest)->prev_physical = rest;
+    block->size = size;
+    insert_free_block(rest);
+}
+
+/**
+ * @brief Round a requested size up to a valid block size.
+ * @param size The requested size in bytes, at most `BLOCK_MAX_SIZE`.
+ * @retval The block size.
+ */
+static size_t adjust_size(size_t size) {
+    size = (size + HEAP_ALIGN - 1) & ~(size_t)(HEAP_ALIGN - 1);
+    return (size < BLOCK_MIN_SIZE) ? BLOCK_MIN_SIZE : size;
+}
+
+/**
+ * @brief Let the heap manage a region of memory, discarding all blocks of the
+ *        region managed before. Blocks are limited to `BLOCK_MAX_SIZE`, so a
+ *        larger region is only used up to that size.
+ * @param start The start of the region.
+ * @param size The size of the region in bytes.
+ * @retval None
+ */
+void heap_init(void *start, size_t size) {
+    uintptr_t first = ((uintptr_t)start + HEAP_ALIGN - 1) & ~(uintptr_t)(HEAP_ALIGN - 1);
+    uintptr_t last = ((uintptr_t)start + size) & ~(uintptr_t)(HEAP_ALIGN - 1);
+    uint32_t primask = enter_critical();
+
+    memset(free_lists, 0, sizeof(free_lists));
+    memset(sl_bitmap, 0, sizeof(sl_bitmap));
+    fl_bitmap = 0;
+    stats = (HeapStats_Type){0};
+
+    if ((last > first) && ((last - first) >= ((2 * BLOCK_HEADER) + BLOCK_MIN_SIZE))) {
+        HeapBlock_Type *block = (HeapBlock_Type *)first;
+        size_t block_bytes = last - first - (2 * BLOCK_HEADER);
+
+        block->prev_physical = NULL;
+        block->size = (block_bytes > BLOCK_MAX_SIZE) ? BLOCK_MAX_SIZE : block_bytes;
+
+        HeapBlock_Type *sentinel = next_physical(block); // a used block of size 0 ending the heap
+        sentinel->prev_physical = block;
+        sentinel->size = 0;
+
+        insert_free_block(block);
+        stats.size = BLOCK_HEADER + block_size(block);
+    }
+
+    exit_critical(primask);
+}
+
+#ifdef PORT_NEWLIB_REENT
+
+extern char _heap_start[]; // start of the `._heap` region of the linker script
+extern char _heap_end[];   // end of the `._heap` region of the linker script
+
+/**
+ * @brief Let the heap manage the `._heap` region of the linker script, up to the
+ *        stacks, which the linker script does not know the size of.
+ * @param None
+ * @retval None
+ */
+static void init_linker_heap(void) {
+    char *end = _heap_end;
+
+    if (end > (char *)(SCHED_STACK_START - SIZE_SCHEDULER_STACK))
+        end = (char *)(SCHED_STACK_START - SIZE_SCHEDULER_STACK);
+    heap_init(_heap_start, (end > _heap_start) ? (size_t)(end - _heap_start) : 0);
+}
+
+#endif // PORT_NEWLIB_REENT
+
+/**
+ * @brief Allocate a block of memory in constant time. Interrupts are disabled
+ *        for the bounded time it takes, so the heap may be used by tasks of any
+ *        priority and from interrupt service routines, and does not block.
+ * @param size The size of the block in bytes.
+ * @retval The block, aligned to two pointers, or NULL if no free block is large enough.
+ */
+void *heap_alloc(size_t size) {
+    uint32_t primask = enter_critical();
+    HeapBlock_Type *block = NULL;
+
+#ifdef PORT_NEWLIB_REENT
+    if (stats.size == 0)
+        init_linker_heap();
+#endif
+
+    if (size <= BLOCK_MAX_SIZE) {
+        size = adjust_size(size);
+        block = take_free_block(size);
+    }
+
+    if (block == NULL) {
+        stats.failures++;
+        exit_critical(primask);
+        return NULL;
+    }
+
+    split_block(block, size);
+    stats.used += BLOCK_HEADER + block_size(block);
+    if (stats.used > stats.peak_used)
+        stats.peak_used = stats.used;
+    stats.allocations++;
+
+    exit_critical(primask);
+    return (void *)((uintptr_t)block + BLOCK_HEADER);
+}
+
+/**
+ * @brief Free a block allocated by `heap_alloc()` in constant time, merging it
+ *        with the free blocks before and after it in memory.
+ * @param ptr The block, or NULL.
+ * @retval None
+ */
+void heap_free(void *ptr) {
+    if (ptr == NULL)
+        return;
+
+    uint32_t primask = enter_critical();
+    HeapBlock_Type *block = (HeapBlock_Type *)((uintptr_t)ptr - BLOCK_HEADER);
+    HeapBlock_Type *next = next_physical(block);
+    HeapBlock_Type *prev = block->prev_physical;
+
+    stats.used -= BLOCK_HEADER + block_size(block);
+
+    if (next->size & BLOCK_FREE) {
+        remove_free_block(next);
+        block->size += BLOCK_HEADER + block_size(next);
+    }
+    if ((prev != NULL) && (prev->size & BLOCK_FREE)) {
+        remove_free_block(prev);
+        prev->size += BLOCK_HEADER + block_size(block);
+        block = prev;
+    }
+    next_physical(block)->prev_physical = block;
+    insert_free_block(block);
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief Change the size of a block allocated by `heap_alloc()`. A block that is
+ *        already large enough is kept, otherwise its contents are moved to a new
+ *        block, which takes time proportional to the size.
+ * @param ptr The block, or NULL to allocate a new one.
+ * @param size The new size in bytes, or 0 to free the block.
+ * @retval The block, or NULL if it could not be resized, in which case `ptr` is still valid.
+ */
+void *heap_realloc(void *ptr, size_t size) {
+    if (ptr == NULL)
+        return heap_alloc(size);
+    if (size == 0) {
+        heap_free(ptr);
+        return NULL;
+    }
+
+    size_t old_size = block_size((HeapBlock_Type *)((uintptr_t)ptr - BLOCK_HEADER));
+    if ((size <= BLOCK_MAX_SIZE) && (adjust_size(size) <= old_size))
+        return ptr;
+
+    void *new_ptr = heap_alloc(size);
+    if (new_ptr != NULL) {
+        memcpy(new_ptr, ptr, old_size);
+        heap_free(ptr);
+    }
+    return new_ptr;
+}
+
+/**
+ * @brief Get a snapshot of the heap statistics. Finding the largest free block
+ *        walks the free list of the highest size class, so unlike allocating
+ *        this is not constant time. Since allocations round the size up to the
+ *        next size class, the largest size reported as allocatable is the
+ *        smallest size of the class of that block, up to 2^-HEAP_SL_LOG2 below it.
+ * @param p_stats Pointer to where the statistics are copied.
+ * @retval None
+ */
+void heap_get_stats(HeapStats_Type *p_stats) {
+    uint32_t primask = enter_critical();
+    size_t largest = 0;
+
+    if (fl_bitmap != 0) {
+        uint32_t fl = highest_bit(fl_bitmap);
+
+        for (HeapBlock_Type *block = free_lists[fl][highest_bit(sl_bitmap[fl])]; block != NULL;
+             block = block->next_free)
+            if (block_size(block) > largest)
+                largest = block_size(block);
+    }
+
+    *p_stats = stats;
+    exit_critical(primask);
+
+    size_t free_bytes = p_stats->size - p_stats->used;
+    p_stats->largest_free = class_floor(largest); // a larger request is rounded up past the block
+    p_stats->fragmentation =
+        free_bytes ? (uint16_t)(10000U - (((uint64_t)(largest + BLOCK_HEADER) * 10000U) / free_bytes)) : 0;
+}
+
+#ifdef PORT_NEWLIB_REENT
+
+/* newlib's allocation functions, which its stdio also uses, are replaced by the heap */
+
+void *_malloc_r(struct _reent *r, size_t size) {
+    void *ptr = heap_alloc(size);
+
+    if (ptr == NULL)
+        r->_errno = ENOMEM;
+    return ptr;
+}
+
+void _free_r(struct _reent *r, void *ptr) {
+    (void)r;
+    heap_free(ptr);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size) {
+    void *new_ptr = heap_realloc(ptr, size);
+
+    if ((new_ptr == NULL) && (size != 0))
+        r->_errno = ENOMEM;
+    return new_ptr;
+}
+
+void *_calloc_r(struct _reent *r, size_t count, size_t size) {
+    void *ptr = NULL;
+
+    if ((size == 0) || (count <= (SIZE_MAX / size)))
+        ptr = _malloc_r(r, count * size);
+    else
+        r->_errno = ENOMEM;
+    if (ptr != NULL)
+        memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void *malloc(size_t size) {
+    return _malloc_r(_REENT, size);
+}
+
+void free(void *ptr) {
+    _free_r(_REENT, ptr);
+}
+
+void *realloc(void *ptr, size_t size) {
+    return _realloc_r(_REENT, ptr, size);
+}
+
+void *calloc(size_t count, size_t size) {
+    return _calloc_r(_REENT, count, size);
+}
+
+#endif // PORT_NEWLIB_REENT
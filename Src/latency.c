@@ -0,0 +1,180 @@
+/**
+ ********************************************************
+ * @file    Src/latency.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          recording the SysTick release latency, the
+ *          PendSV latency and the length of critical
+ *          sections into log-scale histograms, and for
+ *          querying them at runtime.
+ ********************************************************
+ */
+
+#include "latency.h"
+
+#ifdef SCHED_LATENCY
+
+#include "scheduler.h"
+#include "stm32f4xx.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *const source_names[LATENCY_SOURCES] = {"systick", "pendsv", "critical"};
+
+static LatencyHistogram_Type histograms[LATENCY_SOURCES];
+static volatile uint8_t pendsv_pended = 0; // set when the SysTick handler pends PendSV
+static uint32_t pendsv_pended_time = 0;    // timestamp at which the SysTick handler pended PendSV
+static uint32_t critical_enter_time = 0;   // timestamp at which the outermost critical section was entered
+
+/**
+ * @brief Add a sample to the histogram of a latency source. Every source is written
+ *        from a single context, or with interrupts disabled, so no locking is needed.
+ * @param source The latency source.
+ * @param cycles The latency in CPU cycles.
+ * @retval None
+ */
+void latency_record(uint8_t source, uint32_t cycles) {
+    LatencyHistogram_Type *histogram = &histograms[source];
+
+    histogram->buckets[32 - __CLZ(cycles)]++;
+    if (!histogram->count || (cycles < histogram->min))
+        histogram->min = cycles;
+    if (cycles > histogram->max)
+        histogram->max = cycles;
+    histogram->count++;
+}
+
+/**
+ * @brief Note the time at which the SysTick handler pends PendSV.
+ * @param None
+ * @retval None
+ */
+void latency_pendsv_pended(void) {
+    pendsv_pended_time = read_timestamp();
+    pendsv_pended = 1;
+}
+
+/**
+ * @brief Record the PendSV latency if PendSV was pended by the SysTick handler.
+ *        Context switches requested by tasks are not measured.
+ * @param None
+ * @retval None
+ */
+void latency_pendsv_entry(void) {
+    if (pendsv_pended) {
+        latency_record(LATENCY_PENDSV, read_timestamp() - pendsv_pended_time);
+        pendsv_pended = 0;
+    }
+}
+
+/**
+ * @brief Note the time at which the outermost critical section is entered.
+ * @param primask The value of PRIMASK before interrupts were disabled.
+ * @retval None
+ */
+void latency_critical_enter(uint32_t primask) {
+    if (!primask)
+        critical_enter_time = read_timestamp();
+}
+
+/**
+ * @brief Record the length of the outermost critical section, before interrupts are
+ *        enabled again.
+ * @param primask The value of PRIMASK the critical section restores.
+ * @retval None
+ */
+void latency_critical_exit(uint32_t primask) {
+    if (!primask)
+        latency_record(LATENCY_CRITICAL, read_timestamp() - critical_enter_time);
+}
+
+/**
+ * @brief Copy the histogram of a latency source.
+ * @param source The latency source.
+ * @param p_histogram The histogram to copy to.
+ * @retval None
+ */
+void latency_get_histogram(uint8_t source, LatencyHistogram_Type *p_histogram) {
+    uint32_t primask = __get_PRIMASK(); // not enter_critical(), which would measure itself
+
+    __disable_irq();
+    *p_histogram = histograms[source];
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Find the upper bound of the bucket a percentile of the samples falls into.
+ * @param histogram The histogram.
+ * @param per_mille The percentile in tenths of a percent.
+ * @retval The percentile in CPU cycles, capped at the largest sample.
+ */
+static uint32_t percentile(const LatencyHistogram_Type *histogram, uint32_t per_mille) {
+    uint32_t rank = (uint32_t)((((uint64_t)histogram->count * per_mille) + 999) / 1000);
+    uint32_t seen = 0;
+
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; ++i) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = (i == 0) ? 0 : (uint32_t)((1ULL << i) - 1);
+            return (upper < histogram->max) ? upper : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+/**
+ * @brief Summarize the histogram of a latency source.
+ * @param source The latency source.
+ * @param p_stats The summary to fill.
+ * @retval None
+ */
+void latency_get_stats(uint8_t source, LatencyStats_Type *p_stats) {
+    LatencyHistogram_Type histogram;
+
+    latency_get_histogram(source, &histogram);
+    p_stats->count = histogram.count;
+    p_stats->min = histogram.count ? histogram.min : 0;
+    p_stats->max = histogram.max;
+    p_stats->p50 = percentile(&histogram, 500);
+    p_stats->p90 = percentile(&histogram, 900);
+    p_stats->p99 = percentile(&histogram, 990);
+    p_stats->p999 = percentile(&histogram, 999);
+}
+
+/**
+ * @brief Clear the histogram of a latency source.
+ * @param source The latency source.
+ * @retval None
+ */
+void latency_reset(uint8_t source) {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    memset(&histograms[source], 0, sizeof(histograms[source]));
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Print a summary of all latency sources in CPU cycles. Must be called from
+ *        a task.
+ * @param None
+ * @retval None
+ */
+void latency_print(void) {
+    LatencyStats_Type stats;
+
+    printf("source,count,min,p50,p90,p99,p99.9,max\n");
+    for (uint8_t i = 0; i < LATENCY_SOURCES; ++i) {
+        latency_get_stats(i, &stats);
+        printf(
+            "%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n", source_names[i],
+            stats.count, stats.min, stats.p50, stats.p90, stats.p99, stats.p999, stats.max
+        );
+    }
+}
+
+#endif // SCHED_LATENCY
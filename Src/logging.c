@@ -0,0 +1,159 @@
+/**
+ ********************************************************
+ * @file    Src/logging.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          recording binary log records into per-task
+ *          buffers and the low priority log task which
+ *          sends them to the host over the UART.
+ ********************************************************
+ */
+
+#include "logging.h"
+#include "scheduler.h"
+#include "stm32f4xx.h"
+#include "uart.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static LogBuffer_Type task_logs[MAX_TASKS]; // one buffer per task, indexed like `user_tasks`
+static LogBuffer_Type isr_log;              // shared by all ISRs, protected by disabling interrupts
+static uint32_t reported_dropped = 0;       // total number of dropped records already reported to the host
+
+/**
+ * @brief Append a record to a log buffer. The record becomes visible to the log
+ *        task only once `head` is updated, after all of its words are written.
+ * @param log The log buffer to write to.
+ * @param format The address of the format string in the `.log_strings` section.
+ * @param args The arguments of the record.
+ * @param nargs The number of arguments.
+ * @retval None
+ */
+static void write_record(LogBuffer_Type *log, uint32_t format, const uint32_t *args, uint32_t nargs) {
+    uint32_t timestamp = read_timestamp();
+    uint32_t head = log->head;
+
+    if ((nargs > LOG_MAX_ARGS) || ((LOG_BUFFER_WORDS - (head - log->tail)) < (nargs + 2))) {
+        log->dropped++;
+        return;
+    }
+
+    log->words[head++ % LOG_BUFFER_WORDS] = (format << 16) | nargs;
+    log->words[head++ % LOG_BUFFER_WORDS] = timestamp;
+    for (uint32_t i = 0; i < nargs; ++i)
+        log->words[head++ % LOG_BUFFER_WORDS] = args[i];
+
+    __DMB(); // the record must be complete before it is published
+    log->head = head;
+}
+
+/**
+ * @brief Record a log message into the buffer of the current task, or into the
+ *        shared ISR buffer when called from an interrupt service routine. Records
+ *        that do not fit are dropped and counted. Use the `LOG()` macro instead of
+ *        calling this function directly.
+ * @param format The address of the format string in the `.log_strings` section.
+ * @param args The arguments of the record.
+ * @param nargs The number of arguments.
+ * @retval None
+ */
+void log_record(uint32_t format, const uint32_t *args, uint32_t nargs) {
+    if (__get_IPSR() == 0) {
+        write_record(&task_logs[current_task], format, args, nargs);
+    } else {
+        uint32_t primask = enter_critical();
+        write_record(&isr_log, format, args, nargs);
+        exit_critical(primask);
+    }
+}
+
+/**
+ * @brief Send all records of a log buffer to the host. Every record is sent as a
+ *        frame made of the sync byte, the source id, the number of arguments, the
+ *        16-bit format id, the 32-bit timestamp and the 32-bit arguments, all in
+ *        little endian byte order.
+ * @param log The log buffer to drain.
+ * @param source The id of the task which owns the buffer, or `LOG_ISR_SOURCE`.
+ * @retval None
+ */
+static void drain_buffer(LogBuffer_Type *log, uint8_t source) {
+    uint8_t frame[5 + (4 * (LOG_MAX_ARGS + 1))];
+
+    while (log->tail != log->head) {
+        uint32_t tail = log->tail;
+        uint32_t header = log->words[tail++ % LOG_BUFFER_WORDS];
+        uint32_t nargs = header & 0xFF;
+        uint32_t len = 0;
+
+        frame[len++] = LOG_FRAME_SYNC;
+        frame[len++] = source;
+        frame[len++] = (uint8_t)nargs;
+        frame[len++] = (uint8_t)(header >> 16);
+        frame[len++] = (uint8_t)(header >> 24);
+        for (uint32_t i = 0; i < (nargs + 1); ++i) {
+            uint32_t word = log->words[tail++ % LOG_BUFFER_WORDS];
+            frame[len++] = (uint8_t)word;
+            frame[len++] = (uint8_t)(word >> 8);
+            frame[len++] = (uint8_t)(word >> 16);
+            frame[len++] = (uint8_t)(word >> 24);
+        }
+
+        log->tail = tail; // release the space before the potentially blocking write
+        uart_write((const char *)frame, (int)len);
+    }
+}
+
+/**
+ * @brief Report records dropped since the last report as a frame with the reserved
+ *        format id `LOG_DROPPED_FORMAT` and the number of dropped records as argument.
+ * @param None
+ * @retval None
+ */
+static void report_dropped(void) {
+    uint32_t dropped = isr_log.dropped;
+
+    for (size_t i = 0; i < MAX_TASKS; ++i)
+        dropped += task_logs[i].dropped;
+
+    if (dropped != reported_dropped) {
+        uint32_t count = dropped - reported_dropped;
+        uint32_t timestamp = read_timestamp();
+        uint8_t frame[] = {
+            LOG_FRAME_SYNC,
+            LOG_ISR_SOURCE,
+            1,
+            (uint8_t)LOG_DROPPED_FORMAT,
+            (uint8_t)(LOG_DROPPED_FORMAT >> 8),
+            (uint8_t)timestamp,
+            (uint8_t)(timestamp >> 8),
+            (uint8_t)(timestamp >> 16),
+            (uint8_t)(timestamp >> 24),
+            (uint8_t)count,
+            (uint8_t)(count >> 8),
+            (uint8_t)(count >> 16),
+            (uint8_t)(count >> 24)
+        };
+
+        reported_dropped = dropped;
+        uart_write((const char *)frame, sizeof(frame));
+    }
+}
+
+/**
+ * @brief The log task sends the records of all log buffers to the host and then
+ *        sleeps for `LOG_DRAIN_PERIOD` ticks. It runs at a low priority, so the
+ *        cost of transmitting the records is only paid when the system is idle.
+ * @param None
+ * @retval None
+ */
+void log_task(void) {
+    while (1) {
+        for (size_t i = 0; i < MAX_TASKS; ++i)
+            drain_buffer(&task_logs[i], (uint8_t)i);
+        drain_buffer(&isr_log, LOG_ISR_SOURCE);
+        report_dropped();
+
+        task_delay(LOG_DRAIN_PERIOD);
+    }
+}
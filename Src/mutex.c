@@ -0,0 +1,104 @@
+/**
+ ********************************************************
+ * @file    Src/mutex.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          locking and unlocking recursive mutexes.
+ ********************************************************
+ */
+
+#include "mutex.h"
+#include "port.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Initialize a mutex in the unlocked state.
+ * @param mutex The mutex to initialize.
+ * @retval None
+ */
+void mutex_init(Mutex_Type *mutex) {
+    mutex->owner = MUTEX_NO_OWNER;
+    mutex->count = 0;
+}
+
+/**
+ * @brief Lock a mutex, blocking the calling task while it is owned by another task.
+ *        A task that already owns the mutex locks it again without blocking. Outside
+ *        a task, e.g. before the scheduler is launched or in an ISR, the lock only
+ *        succeeds if the mutex is unlocked: `current_task` is then the interrupted
+ *        task, not the caller, so it cannot be told apart from the owner.
+ * @param mutex The mutex to lock.
+ * @param tick_count Timeout in number of ticks, 0 to poll, or `WAIT_FOREVER`.
+ * @retval Non-zero if the mutex was locked, 0 on timeout.
+ */
+uint8_t mutex_lock(Mutex_Type *mutex, uint32_t tick_count) {
+    uint32_t primask = enter_critical();
+    uint8_t locked = 1;
+
+    if ((mutex->owner == MUTEX_NO_OWNER) || ((mutex->owner == current_task) && port_can_block())) {
+        mutex->owner = current_task;
+        mutex->count++;
+    } else if ((tick_count != 0) && task_can_block()) {
+        task_wait(mutex, 0, tick_count);
+        exit_critical(primask);
+
+        // the context switch to another task takes place here
+
+        primask = enter_critical();
+        if (user_tasks[current_task].wait_object != NULL) {
+            user_tasks[current_task].wait_object = NULL; // timed out
+            locked = 0;
+        }
+        // otherwise ownership was handed over by mutex_unlock()
+    } else {
+        locked = 0;
+    }
+
+    exit_critical(primask);
+    return locked;
+}
+
+/**
+ * @brief Unlock a mutex owned by the calling task. Once it has been unlocked as many
+ *        times as it was locked, ownership is handed directly to the first task
+ *        waiting on it, so the mutex cannot be taken over in the meantime.
+ * @param mutex The mutex to unlock.
+ * @retval Non-zero if the mutex was unlocked, 0 if the caller does not own it.
+ */
+uint8_t mutex_unlock(Mutex_Type *mutex) {
+    uint32_t primask = enter_critical();
+
+    if ((mutex->owner != current_task) || (mutex->count == 0)) {
+        exit_critical(primask);
+        return 0;
+    }
+
+    if (--mutex->count == 0)
+        mutex_force_unlock(mutex);
+
+    exit_critical(primask);
+    return 1;
+}
+
+/**
+ * @brief Unlock a mutex whatever its owner and lock count, e.g. a mutex owned by a
+ *        deleted task. Ownership is handed directly to the first task waiting on
+ *        it. Must be called with interrupts disabled.
+ * @param mutex The mutex to unlock.
+ * @retval None
+ */
+void mutex_force_unlock(Mutex_Type *mutex) {
+    mutex->owner = MUTEX_NO_OWNER;
+    mutex->count = 0;
+    for (size_t i = 1; i < MAX_TASKS; ++i) {
+        if ((user_tasks[i].current_state != READY) && (user_tasks[i].wait_object == mutex)) {
+            mutex->owner = i;
+            mutex->count = 1;
+            task_wake(i);
+            break;
+        }
+    }
+}
@@ -0,0 +1,265 @@
+/**
+ ********************************************************
+ * @file    Src/newlib_lock.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains the definitions of the
+ *          locking hooks newlib uses to protect malloc,
+ *          the environment and stdio streams, which are
+ *          implemented with the scheduler's recursive
+ *          mutexes.
+ ********************************************************
+ */
+
+#include "newlib_lock.h"
+#include "mutex.h"
+#include "port.h"
+#include "scheduler.h"
+#include <reent.h>
+#include <stddef.h>
+#include <sys/lock.h>
+
+// number of locks newlib can create at run time: the three standard streams of every task and other FILE streams
+#define NEWLIB_LOCK_POOL_SIZE ((3U * MAX_TASKS) + 8U)
+
+/**
+ * @brief The lock type newlib's retargetable locking
+ *        layer is built around.
+ */
+struct __lock {
+    Mutex_Type mutex; /**< The mutex implementing the lock */
+    uint8_t in_use;   /**< Non-zero while allocated from the lock pool */
+    uint16_t skipped; /**< Acquires that failed outside a task, whose releases are skipped */
+};
+
+// static locks newlib expects the retargeting layer to provide
+struct __lock __lock___sinit_recursive_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___sfp_recursive_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___atexit_recursive_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___at_quick_exit_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___malloc_recursive_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___env_recursive_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___tz_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___dd_hash_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+struct __lock __lock___arc4random_mutex = {.mutex = {.owner = MUTEX_NO_OWNER}};
+
+static struct __lock lock_pool[NEWLIB_LOCK_POOL_SIZE];
+static struct __lock shared_lock = {.mutex = {.owner = MUTEX_NO_OWNER}}; // handed out once the pool is exhausted
+static volatile uint32_t lock_failures = 0;
+
+static struct __lock *const static_locks[] = { // every lock not in the pool
+    &__lock___sinit_recursive_mutex,
+    &__lock___sfp_recursive_mutex,
+    &__lock___atexit_recursive_mutex,
+    &__lock___at_quick_exit_mutex,
+    &__lock___malloc_recursive_mutex,
+    &__lock___env_recursive_mutex,
+    &__lock___tz_mutex,
+    &__lock___dd_hash_mutex,
+    &__lock___arc4random_mutex,
+    &shared_lock
+};
+
+/**
+ * @brief Allocate a lock from the lock pool. Locks are not allocated with
+ *        malloc, since malloc itself depends on locking. Once the pool is
+ *        exhausted, the failure is counted and a lock shared by all such
+ *        objects is handed out, so they are still protected, only coarser.
+ * @param lock Pointer to where the allocated lock is stored.
+ * @retval None
+ */
+void __retarget_lock_init(_LOCK_T *lock) {
+    uint32_t primask = enter_critical();
+
+    *lock = &shared_lock;
+    for (size_t i = 0; i < NEWLIB_LOCK_POOL_SIZE; ++i) {
+        if (!lock_pool[i].in_use) {
+            lock_pool[i].in_use = 1;
+            lock_pool[i].skipped = 0;
+            mutex_init(&lock_pool[i].mutex);
+            *lock = &lock_pool[i];
+            break;
+        }
+    }
+    if (*lock == &shared_lock)
+        lock_failures++;
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief Allocate a recursive lock from the lock pool.
+ * @param lock Pointer to where the allocated lock is stored.
+ * @retval None
+ */
+void __retarget_lock_init_recursive(_LOCK_T *lock) {
+    __retarget_lock_init(lock);
+}
+
+/**
+ * @brief Return a lock to the lock pool.
+ * @param lock The lock to free.
+ * @retval None
+ */
+void __retarget_lock_close(_LOCK_T lock) {
+    if ((lock != NULL) && (lock != &shared_lock))
+        lock->in_use = 0;
+}
+
+/**
+ * @brief Return a recursive lock to the lock pool.
+ * @param lock The lock to free.
+ * @retval None
+ */
+void __retarget_lock_close_recursive(_LOCK_T lock) {
+    __retarget_lock_close(lock);
+}
+
+/**
+ * @brief Acquire a lock, blocking the calling task while another task holds it.
+ *        Where blocking is not allowed, e.g. in an ISR or the idle task, a lock
+ *        that is already held cannot be acquired, not even again by the same
+ *        ISR; the caller then runs unprotected, which is counted as a failure.
+ *        Outside a task the failed acquire is remembered, so that its release
+ *        does not unlock the lock for the task or ISR actually holding it.
+ * @param lock The lock to acquire.
+ * @retval None
+ */
+void __retarget_lock_acquire(_LOCK_T lock) {
+    if ((lock == NULL) || mutex_lock(&lock->mutex, WAIT_FOREVER))
+        return;
+
+    uint32_t primask = enter_critical();
+
+    lock_failures++;
+    if (!port_can_block())
+        lock->skipped++; // ISRs and the code before launch release in reverse order
+    exit_critical(primask);
+}
+
+/**
+ * @brief Acquire a recursive lock, blocking the calling task while another task holds it.
+ * @param lock The lock to acquire.
+ * @retval None
+ */
+void __retarget_lock_acquire_recursive(_LOCK_T lock) {
+    __retarget_lock_acquire(lock);
+}
+
+/**
+ * @brief Try to acquire a lock without blocking.
+ * @param lock The lock to acquire.
+ * @retval Non-zero if the lock was acquired.
+ */
+int __retarget_lock_try_acquire(_LOCK_T lock) {
+    return (lock == NULL) || mutex_lock(&lock->mutex, 0);
+}
+
+/**
+ * @brief Try to acquire a recursive lock without blocking.
+ * @param lock The lock to acquire.
+ * @retval Non-zero if the lock was acquired.
+ */
+int __retarget_lock_try_acquire_recursive(_LOCK_T lock) {
+    return __retarget_lock_try_acquire(lock);
+}
+
+/**
+ * @brief Release a lock, or outside a task skip the release of an acquire that failed.
+ * @param lock The lock to release.
+ * @retval None
+ */
+void __retarget_lock_release(_LOCK_T lock) {
+    if (lock == NULL)
+        return;
+
+    uint32_t primask = enter_critical();
+
+    if (lock->skipped && !port_can_block())
+        lock->skipped--;
+    else
+        mutex_unlock(&lock->mutex);
+    exit_critical(primask);
+}
+
+/**
+ * @brief Release a recursive lock.
+ * @param lock The lock to release.
+ * @retval None
+ */
+void __retarget_lock_release_recursive(_LOCK_T lock) {
+    __retarget_lock_release(lock);
+}
+
+/**
+ * @brief Lock the heap for the calling task while malloc and free modify it.
+ * @param r The reentrancy structure of the calling task.
+ * @retval None
+ */
+void __malloc_lock(struct _reent *r) {
+    (void)r;
+    __retarget_lock_acquire(&__lock___malloc_recursive_mutex);
+}
+
+/**
+ * @brief Unlock the heap locked by `__malloc_lock()`.
+ * @param r The reentrancy structure of the calling task.
+ * @retval None
+ */
+void __malloc_unlock(struct _reent *r) {
+    (void)r;
+    __retarget_lock_release(&__lock___malloc_recursive_mutex);
+}
+
+/**
+ * @brief Lock the environment for the calling task while it is read or modified.
+ * @param r The reentrancy structure of the calling task.
+ * @retval None
+ */
+void __env_lock(struct _reent *r) {
+    (void)r;
+    __retarget_lock_acquire(&__lock___env_recursive_mutex);
+}
+
+/**
+ * @brief Unlock the environment locked by `__env_lock()`.
+ * @param r The reentrancy structure of the calling task.
+ * @retval None
+ */
+void __env_unlock(struct _reent *r) {
+    (void)r;
+    __retarget_lock_release(&__lock___env_recursive_mutex);
+}
+
+/**
+ * @brief Get the number of times newlib could not be given a lock of its own,
+ *        because the lock pool was exhausted, or could not acquire a lock because
+ *        the caller may not block. Non-zero means `NEWLIB_LOCK_POOL_SIZE` is too
+ *        small or newlib is used from an ISR, or before the scheduler is launched,
+ *        where stdio may lock a stream again, e.g. while flushing it.
+ * @param None
+ * @retval The number of locking failures.
+ */
+uint32_t newlib_lock_failures(void) {
+    return lock_failures;
+}
+
+/**
+ * @brief Unlock every newlib lock a task holds, before the task is deleted and its
+ *        newlib state reclaimed, so neither the reclaim nor other tasks wait on
+ *        a lock that would never be released.
+ * @param task The index of the task in `user_tasks`.
+ * @retval None
+ */
+void newlib_lock_release_task(uint16_t task) {
+    uint32_t primask = enter_critical();
+
+    for (size_t i = 0; i < (sizeof(static_locks) / sizeof(static_locks[0])); ++i)
+        if (static_locks[i]->mutex.owner == task)
+            mutex_force_unlock(&static_locks[i]->mutex);
+    for (size_t i = 0; i < NEWLIB_LOCK_POOL_SIZE; ++i)
+        if (lock_pool[i].in_use && (lock_pool[i].mutex.owner == task))
+            mutex_force_unlock(&lock_pool[i].mutex);
+
+    exit_critical(primask);
+}
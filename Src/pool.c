@@ -0,0 +1,86 @@
+/**
+ ********************************************************
+ * @file    Src/pool.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          initializing fixed-block memory pools and
+ *          allocating and freeing their blocks, from
+ *          tasks as well as interrupt service routines.
+ ********************************************************
+ */
+
+#include "pool.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Initialize a pool and link all of its blocks into the free list.
+ * @param pool The pool to initialize.
+ * @param blocks The storage of the blocks, aligned for the data stored in them.
+ * @param block_size The size of every block in bytes; at least the size of a pointer
+ *        and a multiple of its alignment.
+ * @param block_count The number of blocks.
+ * @retval None
+ */
+void pool_init(Pool_Type *pool, void *blocks, size_t block_size, uint32_t block_count) {
+    uint8_t *block = blocks;
+
+    pool->blocks = blocks;
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+    pool->free_list = (block_count != 0) ? blocks : NULL;
+    pool->used = 0;
+    pool->max_used = 0;
+    pool->failures = 0;
+
+    for (uint32_t i = 0; i < block_count; ++i, block += block_size)
+        *(void **)block = (i + 1 < block_count) ? block + block_size : NULL;
+}
+
+/**
+ * @brief Allocate a block of a pool in constant time. This function may be
+ *        called from an interrupt service routine.
+ * @param pool The pool.
+ * @retval The block, or NULL if all blocks are in use.
+ */
+void *pool_alloc(Pool_Type *pool) {
+    uint32_t primask = enter_critical();
+    void *block = pool->free_list;
+
+    if (block != NULL) {
+        pool->free_list = *(void **)block;
+        if (++pool->used > pool->max_used)
+            pool->max_used = pool->used;
+    } else {
+        pool->failures++;
+    }
+
+    exit_critical(primask);
+    return block;
+}
+
+/**
+ * @brief Return a block to its pool in constant time. This function may be
+ *        called from an interrupt service routine.
+ * @param pool The pool the block was allocated from.
+ * @param block The block.
+ * @retval 1 if the block was freed, 0 if it does not belong to the pool.
+ */
+uint8_t pool_free(Pool_Type *pool, void *block) {
+    size_t offset = (size_t)((uint8_t *)block - pool->blocks);
+
+    if (((uint8_t *)block < pool->blocks) || (offset >= (pool->block_size * pool->block_count)) ||
+        ((offset % pool->block_size) != 0))
+        return 0;
+
+    uint32_t primask = enter_critical();
+
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->used--;
+
+    exit_critical(primask);
+    return 1;
+}
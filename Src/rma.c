@@ -0,0 +1,214 @@
+/**
+ ********************************************************
+ * @file    Src/rma.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          assigning rate monotonic priorities, the exact
+ *          response time analysis of periodic tasks and
+ *          the admission control which creates periodic
+ *          tasks only if all of them meet their deadlines.
+ ********************************************************
+ */
+
+#include "rma.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef RMA_HOST_TOOL
+#include "scheduler.h"
+
+static PeriodicTask_Type admitted[MAX_TASKS]; // the periodic tasks admitted so far
+static uint16_t admitted_tasks[MAX_TASKS];    // index of every admitted task in `user_tasks`
+static uint32_t admitted_count = 0;           // the number of admitted tasks
+#endif
+
+/**
+ * @brief Get the relative deadline of a periodic task, which is its period unless a
+ *        shorter deadline is given.
+ * @param task The periodic task.
+ * @retval The relative deadline in ticks.
+ */
+static uint32_t relative_deadline(const PeriodicTask_Type *task) {
+    return (task->deadline && (task->deadline < task->period)) ? task->deadline : task->period;
+}
+
+/**
+ * @brief Divide and round up.
+ * @param dividend The dividend.
+ * @param divisor The divisor, which must not be 0.
+ * @retval The smallest integer not less than the quotient.
+ */
+static uint64_t divide_round_up(uint64_t dividend, uint64_t divisor) {
+    return (dividend + divisor - 1) / divisor;
+}
+
+/**
+ * @brief Assign rate monotonic priorities: the shorter the period, the higher the
+ *        priority. Tasks of equal period get the same priority and are scheduled
+ *        in a round robin fashion. The longest period gets `RMA_BASE_PRIORITY`.
+ * @param tasks The periodic tasks, whose `priority` is written.
+ * @param count The number of periodic tasks.
+ * @retval Non-zero on success, 0 if there are more distinct periods than priorities.
+ */
+uint8_t rma_assign_priorities(PeriodicTask_Type *tasks, uint32_t count) {
+    uint32_t priority = RMA_BASE_PRIORITY;
+    uint64_t assigned_below = UINT64_MAX; // all periods from this one up have been assigned
+
+    while (1) {
+        uint32_t longest = 0;
+        uint8_t found = 0;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if ((tasks[i].period < assigned_below) && (!found || (tasks[i].period > longest))) {
+                longest = tasks[i].period;
+                found = 1;
+            }
+        }
+        if (!found)
+            return 1;
+        if (priority > UINT8_MAX)
+            return 0;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (tasks[i].period == longest)
+                tasks[i].priority = (uint8_t)priority;
+        }
+        priority++;
+        assigned_below = longest;
+    }
+}
+
+/**
+ * @brief Compute the worst case response time of a periodic task with the exact
+ *        response time analysis: starting from its execution time, the response
+ *        time is extended by every job of the tasks of higher or equal priority,
+ *        and by every tick, released within it until it no longer grows. Tasks
+ *        of equal priority are counted because round robin lets them run first.
+ * @param tasks The periodic tasks, with priorities assigned.
+ * @param count The number of periodic tasks.
+ * @param index The index of the task to analyze in `tasks`.
+ * @retval The response time in microseconds, or `RMA_UNSCHEDULABLE` if it exceeds the deadline.
+ */
+uint32_t rma_response_time(const PeriodicTask_Type *tasks, uint32_t count, uint32_t index) {
+    const PeriodicTask_Type *task = &tasks[index];
+    uint64_t deadline = (uint64_t)relative_deadline(task) * RMA_TICK_US;
+    uint64_t response = 0;
+    uint64_t next = task->wcet;
+
+    while (next != response) {
+        if (next > deadline)
+            return RMA_UNSCHEDULABLE;
+
+        response = next;
+        next = task->wcet + (divide_round_up(response, RMA_TICK_US) * RMA_TICK_OVERHEAD_US);
+        for (uint32_t i = 0; i < count; ++i) {
+            if ((i != index) && tasks[i].period && (tasks[i].priority >= task->priority))
+                next += divide_round_up(response, (uint64_t)tasks[i].period * RMA_TICK_US) * tasks[i].wcet;
+        }
+    }
+
+    return (uint32_t)response;
+}
+
+/**
+ * @brief Assign rate monotonic priorities to a set of periodic tasks and compute
+ *        the response time of every task.
+ * @param tasks The periodic tasks, whose `priority` and `response_time` are written.
+ * @param count The number of periodic tasks.
+ * @retval Non-zero if every task meets its deadline.
+ */
+uint8_t rma_analyze(PeriodicTask_Type *tasks, uint32_t count) {
+    uint8_t schedulable = rma_assign_priorities(tasks, count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        tasks[i].response_time = tasks[i].period ? rma_response_time(tasks, count, i) : RMA_UNSCHEDULABLE;
+        if (tasks[i].response_time == RMA_UNSCHEDULABLE)
+            schedulable = 0;
+    }
+
+    return schedulable;
+}
+
+#ifndef RMA_HOST_TOOL
+
+/**
+ * @brief Admit periodic tasks: analyze them together with the tasks admitted by
+ *        earlier calls and, only if every task still meets its deadline, create
+ *        them with their rate monotonic priority and deadline. The priorities of
+ *        the tasks admitted earlier are reassigned. Either all or none of the
+ *        tasks are created. Must not be called by two tasks at the same time.
+ * @param tasks The periodic tasks to admit, whose `priority` and `response_time`
+ *        are written, also when they are rejected.
+ * @param count The number of periodic tasks.
+ * @retval The number of tasks created: `count`, or 0 if they were rejected.
+ */
+uint32_t rma_create_tasks(PeriodicTask_Type *tasks, uint32_t count) {
+    uint32_t total = admitted_count + count;
+    uint32_t primask;
+    uint32_t free_slots = 0;
+    uint8_t schedulable;
+
+    if (total >= MAX_TASKS)
+        return 0;
+
+    memcpy(&admitted[admitted_count], tasks, count * sizeof(PeriodicTask_Type));
+    schedulable = rma_analyze(admitted, total);
+    for (uint32_t i = 0; i < count; ++i) {
+        tasks[i].priority = admitted[admitted_count + i].priority;
+        tasks[i].response_time = admitted[admitted_count + i].response_time;
+    }
+
+    primask = enter_critical();
+    for (size_t i = 1; i < MAX_TASKS; ++i) {
+        if (user_tasks[i].current_state == UNUSED)
+            free_slots++;
+    }
+
+    if (!schedulable || (free_slots < count)) {
+        exit_critical(primask);
+        rma_analyze(admitted, admitted_count); // restore the results of the admitted tasks
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < admitted_count; ++i)
+        task_set_priority(admitted_tasks[i], admitted[i].priority);
+    for (uint32_t i = admitted_count; i < total; ++i) {
+        admitted_tasks[i] = task_create(admitted[i].task_handler, admitted[i].priority);
+        task_set_deadline(admitted_tasks[i], relative_deadline(&admitted[i]));
+    }
+    admitted_count = total;
+
+    exit_critical(primask);
+    return count;
+}
+
+/**
+ * @brief Delete an admitted periodic task and remove it from the admitted tasks,
+ *        so its utilization is available to tasks admitted later. The priorities
+ *        of the remaining tasks are reassigned. Must not be called by two
+ *        tasks at the same time, nor at the same time as `rma_create_tasks()`.
+ * @param task The index of the task in `user_tasks`.
+ * @retval 1 if the task was admitted and is deleted, 0 otherwise.
+ */
+uint8_t rma_delete_task(uint16_t task) {
+    uint32_t i = 0;
+
+    while ((i < admitted_count) && (admitted_tasks[i] != task))
+        i++;
+    if (i == admitted_count)
+        return 0;
+
+    admitted_count--;
+    memmove(&admitted[i], &admitted[i + 1], (admitted_count - i) * sizeof(PeriodicTask_Type));
+    memmove(&admitted_tasks[i], &admitted_tasks[i + 1], (admitted_count - i) * sizeof(uint16_t));
+    rma_analyze(admitted, admitted_count);
+    for (i = 0; i < admitted_count; ++i)
+        task_set_priority(admitted_tasks[i], admitted[i].priority);
+
+    task_delete(task); // does not return if the task deletes itself
+    return 1;
+}
+
+#endif // RMA_HOST_TOOL
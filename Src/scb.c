@@ -23,6 +23,18 @@ void enable_processor_faults(void) {
     SCB->SHCSR |= (SCB_SHCSR_USGFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_MEMFAULTENA_Msk);
 }
 
+/**
+ * @brief Enable the free running cycle counter of the Data Watchpoint
+ *        and Trace (DWT) unit, which is used to timestamp kernel events.
+ * @param None
+ * @retval None
+ */
+void enable_cycle_counter(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
 /**
  * @brief Function handler to be called when a Bus Fault
  *        Exception handler occurs.
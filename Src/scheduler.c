@@ -3,211 +3,743 @@
  * @file    Src/scheduler.c
  * @author  Jacob Zarnstorff
  * @date    09-January-2025
- * @brief   This file contains function definitions for
- *          initializing tasks, launching the round robin
- *          scheduler, and the interrupt service routines
- *          that is used switching context between tasks.
+ * @brief   This file contains the hardware independent
+ *          kernel: function definitions for initializing
+ *          tasks, blocking and waking them, launching the
+ *          round robin or earliest deadline first (EDF)
+ *          scheduler, and the tick and context switch
+ *          logic called by the port.
  ********************************************************
  */
 
 #include "scheduler.h"
-#include "stm32f4xx.h"
+#include "latency.h"
+#ifdef PORT_NEWLIB_REENT
+#include "newlib_lock.h"
+#endif
+#include "port.h"
+#include "sched_hooks.h"
 #include "tasks.h"
+#include "trace.h"
+#include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 
-uint8_t current_task = 1;
+uint16_t current_task = 0;
 uint32_t g_tick_count = 0;
 
+static uint32_t last_switch_time = 0; // timestamp when `current_task` was switched in
+static void (*deadline_callback)(uint16_t task, uint32_t lateness) = NULL;
+static uint8_t deleted_tasks; // the wait object of tasks which are being deleted
+#ifdef SCHED_EDF
+static uint16_t ready_heap[MAX_TASKS];     // binary min-heap of the READY tasks, ordered by `runs_before()`
+static uint16_t heap_position[MAX_TASKS];  // index of every READY task in `ready_heap`
+static uint16_t ready_count = 0;           // the number of tasks in `ready_heap`
+static uint32_t ready_sequence[MAX_TASKS]; // round robin order of the READY tasks without a deadline
+static uint32_t next_sequence = 0;
+#else
+static uint32_t ready_tasks[(MAX_TASKS + 31) / 32]; // bit n is set while task n is READY
+#endif
+
 TCB_Type user_tasks[MAX_TASKS] = {
-    {.psp_value = IDLE_STACK_START, .task_handler = idle_task},
-    {.psp_value = T0_STACK_START, .task_handler = task_0_handler},
-    {.psp_value = T1_STACK_START, .task_handler = task_1_handler},
-    {.psp_value = T2_STACK_START, .task_handler = task_2_handler},
-    {.psp_value = T3_STACK_START, .task_handler = task_3_handler}
+    {.task_handler = idle_task, .priority = IDLE_TASK_PRIORITY}
 };
 
+static void update_next_task(void);
+
+#ifdef SCHED_EDF
+
+/**
+ * @brief Check if a READY task must be scheduled before another one: the higher
+ *        priority runs first, and among tasks of equal priority the earliest
+ *        absolute deadline. Tasks without a deadline come after the tasks with a
+ *        deadline of their priority and are scheduled in a round robin fashion.
+ * @param a The index of the first task in `user_tasks`.
+ * @param b The index of the second task in `user_tasks`.
+ * @retval Non-zero if task `a` runs before task `b`.
+ */
+static int runs_before(uint16_t a, uint16_t b) {
+    const TCB_Type *task_a = &user_tasks[a];
+    const TCB_Type *task_b = &user_tasks[b];
+
+    if (task_a->priority != task_b->priority)
+        return task_a->priority > task_b->priority;
+    if (!task_a->relative_deadline != !task_b->relative_deadline)
+        return task_a->relative_deadline != 0;
+    if (!task_a->relative_deadline)
+        return (int32_t)(ready_sequence[a] - ready_sequence[b]) < 0;
+    return (int32_t)(task_a->absolute_deadline - task_b->absolute_deadline) < 0;
+}
+
 /**
- * @brief Initialize the SysTick timer on the Cortex M4 microcontroller.
- * @param tick_hz Value in cycles per second the SysTick interrupt should trigger.
+ * @brief Store a task at a position of the ready heap.
+ * @param position The index in `ready_heap`.
+ * @param task The index of the task in `user_tasks`.
  * @retval None
  */
-static void init_systick_timer(uint32_t tick_hz) {
-    SysTick_Config(tick_hz);
+static void place_in_heap(uint16_t position, uint16_t task) {
+    ready_heap[position] = task;
+    heap_position[task] = position;
 }
 
 /**
- * @brief Initialize a dummy stack frame for all tasks.
- * @param None
+ * @brief Restore the heap order after the key of a task in the ready heap became
+ *        smaller or larger, by moving the task up or down the heap.
+ * @param task The index of the task in `user_tasks`.
  * @retval None
  */
-void init_tasks_stack(void) {
-    uint32_t *p_PSP = NULL;
+static void update_ready_heap(uint16_t task) {
+    uint16_t position = heap_position[task];
 
-    for (size_t i = 0; i < MAX_TASKS; ++i) {
-        user_tasks[i].current_state = READY;
-        p_PSP = (uint32_t *)user_tasks[i].psp_value;
-        --p_PSP;
-        *p_PSP = xPSR_T_Msk;
+    while ((position > 0) && runs_before(task, ready_heap[(position - 1) / 2])) {
+        place_in_heap(position, ready_heap[(position - 1) / 2]);
+        position = (position - 1) / 2;
+    }
 
-        --p_PSP; // program counter
-        *p_PSP = (uint32_t)user_tasks[i].task_handler;
+    while (1) {
+        uint16_t child = (2 * position) + 1;
+
+        if (child >= ready_count)
+            break;
+        if (((child + 1) < ready_count) && runs_before(ready_heap[child + 1], ready_heap[child]))
+            child++;
+        if (!runs_before(ready_heap[child], task))
+            break;
+        place_in_heap(position, ready_heap[child]);
+        position = child;
+    }
 
-        --p_PSP; // link register
-        *p_PSP = 0xFFFFFFFD;
+    place_in_heap(position, task);
+}
 
-        // configure CPU registers R0-R12 with dummy
-        // values of 0 in task's private stack
-        for (unsigned char j = 0; j < 13; ++j) {
-            --p_PSP;
-            *p_PSP = 0;
+/**
+ * @brief Set the state of a task and keep the ready heap up to date. The idle task
+ *        is never kept in the heap; it runs when the heap is empty. All state
+ *        changes go through this function.
+ * @param task The index of the task in `user_tasks`.
+ * @param state The new state of the task.
+ * @retval None
+ */
+static void set_task_state(uint16_t task, uint8_t state) {
+    uint8_t was_ready = user_tasks[task].current_state == READY;
+
+    user_tasks[task].current_state = state;
+    if (state != READY)
+        user_tasks[task].slice_left = 0; // a task gets a new time slice once it is READY again
+    if ((task == 0) || (was_ready == (state == READY)))
+        return;
+
+    if (state == READY) {
+        ready_sequence[task] = next_sequence++;
+        place_in_heap(ready_count++, task);
+        update_ready_heap(task);
+    } else {
+        uint16_t last = ready_heap[--ready_count];
+
+        if (last != task) {
+            place_in_heap(heap_position[task], last);
+            update_ready_heap(last);
         }
+    }
+}
 
-        user_tasks[i].psp_value = (uint32_t)p_PSP;
+/**
+ * @brief Check the invariants of the ready heap: it holds every READY task but
+ *        the idle task exactly once, `heap_position` points back at every entry
+ *        and no task runs before its parent. Takes time proportional to
+ *        `MAX_TASKS`, so it is meant for the simulator, not the tick.
+ * @param None
+ * @retval Non-zero if the ready heap is consistent.
+ */
+uint8_t sched_check_ready_heap(void) {
+    uint16_t ready = 0;
+
+    for (uint16_t task = 1; task < MAX_TASKS; ++task)
+        if (user_tasks[task].current_state == READY)
+            ready++;
+    if (ready != ready_count)
+        return 0;
+
+    for (uint16_t position = 0; position < ready_count; ++position) {
+        uint16_t task = ready_heap[position];
+
+        if ((task == 0) || (task >= MAX_TASKS) || (user_tasks[task].current_state != READY) ||
+            (heap_position[task] != position))
+            return 0;
+        if ((position > 0) && runs_before(task, ready_heap[(position - 1) / 2]))
+            return 0;
     }
+
+    return 1;
 }
 
+#else
+
 /**
- * @brief A delay to simulate work for a task.
- * @param tick_count Value in number of ticks in reference to SysTick a task will delay.
+ * @brief Set the state of a task and keep the bitmap of READY tasks up to date.
+ *        All state changes go through this function.
+ * @param task The index of the task in `user_tasks`.
+ * @param state The new state of the task.
  * @retval None
  */
-void task_delay(uint32_t tick_count) {
-    __disable_irq();
+static void set_task_state(uint16_t task, uint8_t state) {
+    user_tasks[task].current_state = state;
+    if (state == READY) {
+        ready_tasks[task / 32] |= 1U << (task % 32);
+    } else {
+        ready_tasks[task / 32] &= ~(1U << (task % 32));
+        user_tasks[task].slice_left = 0; // a task gets a new time slice once it is READY again
+    }
+}
 
-    if (current_task) {
-        user_tasks[current_task].block_count = g_tick_count + tick_count;
-        user_tasks[current_task].current_state = BLOCKED;
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+#endif // SCHED_EDF
+
+/**
+ * @brief Check if a task which became READY must run before the running task: if
+ *        the running task is no longer READY, or the task has a higher priority,
+ *        or with `SCHED_EDF` runs before it. Other tasks wait until the time slice
+ *        of the running task expires.
+ * @param task The index of the task in `user_tasks`.
+ * @retval Non-zero if a context switch is needed.
+ */
+static int preempts(uint16_t task) {
+    if ((current_task == 0) || (user_tasks[current_task].current_state != READY))
+        return 1;
+#ifdef SCHED_EDF
+    return runs_before(task, current_task);
+#else
+    return user_tasks[task].priority > user_tasks[current_task].priority;
+#endif
+}
+
+/**
+ * @brief Start a new time slice for the task that was just switched in, unless it
+ *        resumes after being preempted with part of its time slice left. The idle
+ *        task has no time slice; it runs until another task becomes READY.
+ * @param None
+ * @retval None
+ */
+static void start_time_slice(void) {
+    TCB_Type *task = &user_tasks[current_task];
+
+    if (current_task && !task->slice_left)
+        task->slice_left = task->time_slice ? task->time_slice : TIME_SLICE_TICKS;
+}
+
+/**
+ * @brief Let the port initialize the context of a task and mark it as READY.
+ * @param task The index of the task in `user_tasks`.
+ * @retval None
+ */
+static void init_task_stack(uint16_t task) {
+    set_task_state(task, READY);
+    port_init_task_stack(task);
+}
+
+/**
+ * @brief Create a task in the first unused slot of `user_tasks`, using the stack that
+ *        belongs to that slot. Tasks can be created before the scheduler is launched,
+ *        on the Cortex M4 after the Main Stack Pointer has been moved with
+ *        `init_scheduler_stack()`, or by a running task.
+ * @param task_handler The task's handler function; returning from it calls `task_exit()`.
+ * @param priority The task's priority; higher values are scheduled first.
+ * @retval The index of the task in `user_tasks`, or 0 if all slots are in use.
+ */
+uint16_t task_create(void (*task_handler)(void), uint8_t priority) {
+    uint32_t primask = enter_critical();
+    uint16_t task = 0;
+
+    for (size_t i = 1; i < MAX_TASKS; ++i) {
+        if (user_tasks[i].current_state == UNUSED) {
+            task = i;
+            break;
+        }
+    }
+
+    if (task) {
+        uint16_t generation = user_tasks[task].generation + 1; // tells statistics the slot was reused
+
+        user_tasks[task] = (TCB_Type){.task_handler = task_handler, .priority = priority, .generation = generation};
+        init_task_stack(task);
     }
 
-    __enable_irq();
+    exit_critical(primask);
+    return task;
 }
 
+#ifdef PORT_NEWLIB_REENT
 /**
- * @brief Set the address for the Main Stack Pointer (MSP) of the Cortex M4 microcontroller.
- * @param scheduler_stack_start The desired address in RAM the MSP should point to.
+ * @brief Release the newlib state of a task, such as its stdio buffers and
+ *        stream locks, after unlocking the newlib locks it holds.
+ * @param task The index of the task in `user_tasks`.
  * @retval None
  */
-__attribute__((naked)) void init_scheduler_stack(uint32_t scheduler_stack_start) {
-    __set_MSP(scheduler_stack_start);
-    __asm volatile("BX LR");
+static void reclaim_task_reent(uint16_t task) {
+    newlib_lock_release_task(task);
+    if (task == current_task)
+        _impure_ptr = _global_impure_ptr; // `_reclaim_reent()` skips the state in use
+    _reclaim_reent(&user_tasks[task].reent);
 }
+#endif
 
 /**
- * @brief Switch from using the Main Stack Pointer (MSP) to the Process Stack Pointer (PSP).
+ * @brief Delete a task, which never runs again. The task is removed from the READY
+ *        tasks and from the kernel object it waits on, if any, and its slot in
+ *        `user_tasks` and the stack that belongs to it are free for `task_create()`.
+ *        Called from a task, it also unlocks the newlib locks of the deleted task
+ *        and releases its newlib state; called from an ISR, that state leaks.
+ *        Mutexes the task owns stay locked, so a task should rather be asked to
+ *        release them and call `task_exit()`. When a task deletes itself with
+ *        interrupts enabled this function does not return. Safe to use from an ISR.
+ * @param task The index of the task in `user_tasks`; the idle task cannot be deleted.
+ * @retval None
+ */
+void task_delete(uint16_t task) {
+    uint32_t primask;
+
+    if ((task == 0) || (task >= MAX_TASKS) || (user_tasks[task].current_state == UNUSED))
+        return;
+
+    if (task != current_task) {
+        // keep the slot while the newlib state is released: the task waits on
+        // nothing, so no kernel object or timeout makes it READY again
+        primask = enter_critical();
+        if ((user_tasks[task].current_state == UNUSED) || (user_tasks[task].wait_object == &deleted_tasks)) {
+            exit_critical(primask);
+            return; // deleted in the meantime
+        }
+        set_task_state(task, WAITING);
+        user_tasks[task].wait_object = &deleted_tasks;
+        user_tasks[task].budget = 0; // the tick no longer replenishes the slot
+        exit_critical(primask);
+    }
+
+#ifdef PORT_NEWLIB_REENT
+    if (task_can_block()) // `free()` takes the malloc lock
+        reclaim_task_reent(task);
+#endif
+
+    primask = enter_critical();
+    set_task_state(task, UNUSED);
+    user_tasks[task].wait_object = NULL; // kernel objects wake the tasks that wait on them
+    user_tasks[task].budget = 0;
+    if (task == current_task)
+        port_pend_switch();
+    exit_critical(primask);
+}
+
+/**
+ * @brief End the current task and free its slot and stack for `task_create()`. A
+ *        task handler which returns ends up here. The newlib state of the task is
+ *        released as well. Must be called with interrupts enabled. Does not return.
  * @param None
  * @retval None
  */
-__attribute__((naked)) static void switch_sp_to_psp(void) {
-    // initialize the PSP with TASK1 stack start
+void task_exit(void) {
+    task_delete(current_task);
+
+    while (1) // not reached once interrupts are enabled
+        ;
+}
 
-    // get the value of PSP of current_task
-    __asm volatile("PUSH {LR}");        // preserve LR which returns back to main
-    __asm volatile("BL get_psp_value"); // stack of current_task will be stored in R0
-    __asm volatile("MSR PSP, R0");      // initialize PSP
-    __asm volatile("POP {LR}");         // pops back LR value
+/**
+ * @brief Set the relative deadline of a periodic task, usually its period. A task
+ *        releases a job every time its `task_delay()` or `task_delay_until()`
+ *        expires and the job is due `relative_deadline` ticks later; blocking on a
+ *        kernel object in between does not change the deadline. The deadline of the
+ *        current job is counted from now. Jobs completed late are counted in the
+ *        task's `deadline_misses`. With `SCHED_EDF`, tasks of equal priority are
+ *        also scheduled by the earliest deadline.
+ * @param task The index of the task in `user_tasks`.
+ * @param relative_deadline The deadline in ticks after every release, or 0 for none.
+ * @retval None
+ */
+void task_set_deadline(uint16_t task, uint32_t relative_deadline) {
+    uint32_t primask = enter_critical();
 
-    // change SP to PSP using CONTROL register
-    __asm volatile("MOV R0, #0X02");
-    __asm volatile("MSR CONTROL, R0");
-    __asm volatile("BX LR");
+    user_tasks[task].relative_deadline = relative_deadline;
+    user_tasks[task].absolute_deadline = g_tick_count + relative_deadline;
+#ifdef SCHED_EDF
+    if (task && (user_tasks[task].current_state == READY))
+        update_ready_heap(task);
+#endif
+
+    exit_critical(primask);
 }
 
 /**
- * @brief Initialize the SysTick timer, switch from using the Main Stack Pointer (MSP) to
- *        the Process Stack Pointer (PSP), and call the task handler of the current task.
- * @param tick_hz Value in cycles per second the SysTick interrupt should trigger.
+ * @brief Change the priority of a task, e.g. when priorities are reassigned as
+ *        periodic tasks are admitted. The change takes effect at the next context
+ *        switch, at the latest on the next tick.
+ * @param task The index of the task in `user_tasks`.
+ * @param priority The task's new priority; higher values are scheduled first.
  * @retval None
  */
-void launch_scheduler(uint32_t systick_hz) {
-    init_systick_timer(systick_hz);
-    switch_sp_to_psp();
-    user_tasks[current_task].task_handler();
+void task_set_priority(uint16_t task, uint8_t priority) {
+    uint32_t primask = enter_critical();
+
+    user_tasks[task].priority = priority;
+#ifdef SCHED_EDF
+    if (task && (user_tasks[task].current_state == READY))
+        update_ready_heap(task);
+#endif
+
+    exit_critical(primask);
 }
 
 /**
- * @brief Get the Process Stack Pointer (PSP) address of the current running task.
+ * @brief Set the time slice of a task: the number of ticks it runs before the next
+ *        READY task of equal priority gets the CPU. Longer time slices trade the
+ *        response time of tasks of equal priority for fewer context switches;
+ *        higher priority tasks still preempt the task as soon as they are READY,
+ *        after which it resumes with the rest of its time slice. Takes effect at
+ *        the start of the task's next time slice.
+ * @param task The index of the task in `user_tasks`.
+ * @param ticks The time slice in ticks, or 0 for `TIME_SLICE_TICKS`.
+ * @retval None
+ */
+void task_set_time_slice(uint16_t task, uint16_t ticks) {
+    user_tasks[task].time_slice = ticks;
+}
+
+/**
+ * @brief Limit the CPU time of a task, isolating the other tasks from it when it
+ *        runs away: every `period` ticks the task may run for `budget` timestamp
+ *        counts, e.g. `TICK_HZ_MS / 2` for half a millisecond. A task which used up
+ *        its budget is THROTTLED, checked on every tick, until the budget is
+ *        replenished at the end of the period. Time the task ran over its budget
+ *        before the tick caught it is deducted from the next budget. A task must
+ *        not be throttled while it holds a mutex other tasks depend on.
+ * @param task The index of the task in `user_tasks`.
+ * @param budget The CPU time per period in timestamp counts, or 0 for no limit.
+ * @param period The replenishment period in ticks; must be at least 1.
+ * @retval None
+ */
+void task_set_budget(uint16_t task, uint32_t budget, uint32_t period) {
+    uint32_t primask = enter_critical();
+
+    user_tasks[task].budget = budget;
+    user_tasks[task].budget_period = period;
+    user_tasks[task].budget_left = (int32_t)budget;
+    user_tasks[task].replenish_tick = g_tick_count + period;
+    if (!budget && (user_tasks[task].current_state == THROTTLED)) {
+        set_task_state(task, READY);
+        TRACE_TASK_UNBLOCK(task);
+    }
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief Set the function called when a task completes a job after its deadline.
+ *        It is called by the late task itself, from `task_delay()` or
+ *        `task_delay_until()`, so it may log or block but should be short.
+ * @param callback The function called with the index of the late task and its
+ *        lateness in ticks, or NULL for none.
+ * @retval None
+ */
+void task_set_deadline_callback(void (*callback)(uint16_t task, uint32_t lateness)) {
+    deadline_callback = callback;
+}
+
+/**
+ * @brief Check if the job the current task completes met its deadline, and count
+ *        it as a miss if the tick of its deadline has passed. The lateness is in
+ *        whole ticks, rounded up.
  * @param None
- * @retval The address of the current task's stack pointer.
+ * @retval None
  */
-static uint32_t get_psp_value(void) {
-    return user_tasks[current_task].psp_value;
+static void complete_job(void) {
+    TCB_Type *task = &user_tasks[current_task];
+    uint32_t lateness = g_tick_count - task->absolute_deadline + 1;
+
+    if (!task->relative_deadline || ((int32_t)lateness <= 0))
+        return;
+
+    task->deadline_misses++;
+    if (lateness > task->worst_lateness)
+        task->worst_lateness = lateness;
+    if (deadline_callback != NULL)
+        deadline_callback(current_task, lateness);
 }
 
 /**
- * @brief Update the Process Stack Pointer (PSP) address of the current running task to a new value.
- * @param current_psp_value The new address of the current task's stack pointer.
+ * @brief Block the current task until a number of ticks from now. For a task with a
+ *        deadline, the next job is released then and due `relative_deadline` later.
+ *        Must be called with interrupts disabled.
+ * @param tick_count The number of ticks to block for; must be at least 1.
  * @retval None
  */
-static void save_psp_value(uint32_t current_psp_value) {
-    user_tasks[current_task].psp_value = current_psp_value;
+static void delay_current_task(uint32_t tick_count) {
+    user_tasks[current_task].block_count = g_tick_count + tick_count;
+    user_tasks[current_task].absolute_deadline =
+        user_tasks[current_task].block_count + user_tasks[current_task].relative_deadline;
+    set_task_state(current_task, BLOCKED);
+    TRACE_TASK_BLOCK(current_task, tick_count);
+    port_pend_switch();
 }
 
 /**
- * @brief Update the value of `current_task` to the next task in the READY state
- *        in a round robin fashion. If the state of all user-defined tasks are set
- *        to BLOCKED, the idle task is chosen.
+ * @brief A delay to simulate work for a task. For a task with a deadline, this ends
+ *        the current job, which is checked against its deadline, and the next one
+ *        is released once the delay expires.
+ * @param tick_count Value in number of ticks in reference to SysTick a task will delay.
+ * @retval None
+ */
+void task_delay(uint32_t tick_count) {
+    uint32_t primask;
+
+    if (current_task)
+        complete_job();
+
+    primask = enter_critical();
+    if (current_task)
+        delay_current_task(tick_count);
+    exit_critical(primask);
+}
+
+/**
+ * @brief Block a periodic task until its next release, `period` ticks after the
+ *        previous one, so releases do not drift by the execution time of the jobs
+ *        as with `task_delay()`. The current job is checked against its deadline.
+ *        If the next release has already passed because the job overran its
+ *        period, the releases that passed are skipped and counted as overruns and
+ *        the task waits for the first release in the future.
+ * @param release_tick The tick count of the previous release, which is updated to the
+ *        next one; initialize it to `g_tick_count` before the first job.
+ * @param period The period of the task in ticks; must be at least 1.
+ * @retval None
+ */
+void task_delay_until(uint32_t *release_tick, uint32_t period) {
+    uint32_t primask;
+
+    if (!current_task)
+        return;
+
+    complete_job();
+
+    primask = enter_critical();
+    *release_tick += period;
+    while ((int32_t)(*release_tick - g_tick_count) <= 0) {
+        *release_tick += period;
+        user_tasks[current_task].overruns++;
+    }
+    delay_current_task(*release_tick - g_tick_count);
+    exit_critical(primask);
+}
+
+/**
+ * @brief Give up the rest of the current time slice to the next READY task of the
+ *        same or a higher priority.
  * @param None
  * @retval None
  */
-static void update_next_task(void) {
-    int state = BLOCKED;
+void task_yield(void) {
+    user_tasks[current_task].slice_left = 0;
+    port_pend_switch();
+}
 
-    for (size_t i = 0; i < MAX_TASKS; ++i) {
-        current_task = (current_task + 1) % MAX_TASKS; // attempt to set current_task to the next task
-        state = user_tasks[current_task].current_state;
-        if ((state == READY) && (current_task != 0)) // check if this task is marked as READY; IDLE task is always ready
-            break; // if any task is ready, we exit loop and local variable `state` will be assigned READY
+/**
+ * @brief Disable interrupts and return the previous interrupt mask so critical
+ *        sections can be nested and entered from both tasks and ISRs.
+ * @param None
+ * @retval The value of PRIMASK before interrupts were disabled.
+ */
+uint32_t enter_critical(void) {
+    uint32_t primask = port_enter_critical();
+    LATENCY_CRITICAL_ENTER(primask);
+    return primask;
+}
+
+/**
+ * @brief Restore the interrupt mask saved by `enter_critical()`.
+ * @param primask The value returned by the matching call to `enter_critical()`.
+ * @retval None
+ */
+void exit_critical(uint32_t primask) {
+    LATENCY_CRITICAL_EXIT(primask);
+    port_exit_critical(primask);
+}
+
+/**
+ * @brief Block the current task on a kernel object. Must be called with interrupts
+ *        disabled; the context switch takes place once interrupts are enabled again.
+ *        The task is made READY again either by `task_wake()`, which clears its
+ *        `wait_object`, or by the SysTick handler once the timeout expires, in
+ *        which case `wait_object` is left set so the caller can detect the timeout.
+ * @param wait_object The kernel object the task is waiting on.
+ * @param wait_value Object specific value describing what the task waits for.
+ * @param tick_count Timeout in number of ticks, or `WAIT_FOREVER` to wait without a timeout.
+ * @retval None
+ */
+void task_wait(void *wait_object, uint32_t wait_value, uint32_t tick_count) {
+    if (current_task) {
+        user_tasks[current_task].wait_object = wait_object;
+        user_tasks[current_task].wait_value = wait_value;
+        if (tick_count == WAIT_FOREVER) {
+            set_task_state(current_task, WAITING);
+            TRACE_TASK_BLOCK(current_task, 0);
+        } else {
+            user_tasks[current_task].block_count = g_tick_count + tick_count;
+            set_task_state(current_task, BLOCKED);
+            TRACE_TASK_BLOCK(current_task, tick_count);
+        }
+        port_pend_switch();
     }
+}
+
+/**
+ * @brief Mark a task blocked on a kernel object as READY and pend a context switch
+ *        if it preempts the running task. Must be called with interrupts disabled;
+ *        safe to use from an ISR.
+ * @param task The index of the task in `user_tasks` to wake.
+ * @retval None
+ */
+void task_wake(uint16_t task) {
+    user_tasks[task].wait_object = NULL;
+    set_task_state(task, READY);
+    TRACE_TASK_UNBLOCK(task);
+    if (preempts(task))
+        port_pend_switch();
+}
+
+/**
+ * @brief Check if the caller is allowed to block, which is only the case when it
+ *        runs in a task after the scheduler has been launched, as opposed to an
+ *        interrupt handler or `main()`, and it is not the idle task.
+ * @param None
+ * @retval Non-zero if the caller may call `task_wait()`.
+ */
+uint8_t task_can_block(void) {
+    return port_can_block() && (current_task != 0);
+}
+
+/**
+ * @brief Add the time since the last call, or since the task was switched in, to
+ *        the run time of `current_task`. Called on every context switch; other
+ *        callers must disable interrupts.
+ * @param None
+ * @retval None
+ */
+void update_run_time(void) {
+    uint32_t now = read_timestamp();
+    TCB_Type *task = &user_tasks[current_task];
+
+    task->run_time += now - last_switch_time;
+    if (task->budget)
+        task->budget_left -= (int32_t)(now - last_switch_time);
+    last_switch_time = now;
+}
 
-    if (state != READY)   // all tasks blocked
-        current_task = 0; // set current_task to the idle task
+/**
+ * @brief Initialize the idle task, choose the first task to run and let the port
+ *        start the tick and switch to that task. Does not return.
+ * @param tick_period The time between ticks in timestamp counts; `TICK_HZ_MS` for 1 ms.
+ * @retval None
+ */
+void launch_scheduler(uint32_t tick_period) {
+    init_task_stack(0); // the idle task
+    update_next_task(); // start with the highest priority task that was created
+    start_time_slice();
+    last_switch_time = read_timestamp();
+    TRACE_TASK_SWITCH_IN(current_task);
+    port_start_scheduler(tick_period);
 }
 
 /**
- * @brief Interrupt Service Routine for the PendSV exception which handles the
- *        context switching between tasks. The PendSV exception is chosen to do
- *        the context switching due to the exception having the lowest priority.
- *        If the context switching was carried out in an interrupt with a very
- *        high priority like the SysTick handler, there could be a possibility
- *        of an interrupt with a lower priority being pre-empted in the middle
- *        of an ISR by the SysTick hanlder. This would lead to the context being
- *        switched back to a task instead of returning to back the ISR that was
- *        interrupted leading to a UsageFault.
+ * @brief Called by the port's context switch with interrupts disabled, once the
+ *        context of `current_task` has been saved, to charge its run time and
+ *        choose the next task to run. The port then restores the context of the
+ *        new `current_task`.
  * @param None
  * @retval None
  */
-__attribute__((naked)) void PendSV_Handler(void) {
-    /* Save the context of current_task */
-    // get current running task's PSP value
-    __asm volatile("MRS R0, PSP");
+void sched_switch_context(void) {
+    SCHED_HOOK_PENDSV_ENTER();
+    LATENCY_PENDSV_ENTRY();
+    TRACE_TASK_SWITCH_OUT(current_task);
+    update_run_time();
+    update_next_task();
+    start_time_slice();
+    TRACE_TASK_SWITCH_IN(current_task);
+}
 
-    // using that PSP value, store SF2 [R4:R11]
-    // STMDB = store multiple registers and decrement before
-    __asm volatile("STMDB R0!, {R4-R11}");
+#ifdef SCHED_EDF
 
-    // save the current value of PSP
-    __asm volatile("PUSH {LR}");
-    __asm volatile("BL save_psp_value");
+/**
+ * @brief Update the value of `current_task` to the READY task at the top of the
+ *        ready heap: the highest priority task with the earliest deadline. The
+ *        running task, if it has no deadline and its time slice expired, is first
+ *        moved behind the other READY tasks without a deadline of its priority, so
+ *        those are chosen in a round robin fashion. If all user-defined tasks are
+ *        blocked, the idle task is chosen.
+ * @param None
+ * @retval None
+ */
+static void update_next_task(void) {
+    if (current_task && (user_tasks[current_task].current_state == READY) &&
+        !user_tasks[current_task].relative_deadline && !user_tasks[current_task].slice_left) {
+        ready_sequence[current_task] = next_sequence++;
+        update_ready_heap(current_task);
+    }
 
-    /* Retrieve the context of next task */
-    // decide next task to run
-    __asm volatile("BL update_next_task");
+    current_task = ready_count ? ready_heap[0] : 0;
+}
 
-    // get its past PSP value
-    __asm volatile("BL get_psp_value");
+#else
 
-    // using that PSP value, retrieve SF2 [R4:R11]
-    // LDMIA = load multiple registers and increment after
-    __asm volatile("LDMIA R0!, {R4-R11}");
+/**
+ * @brief Find the highest priority READY task among a range of tasks, visiting them
+ *        in index order. Among tasks of equal priority, a task that was preempted
+ *        with part of its time slice left wins, otherwise the first READY task.
+ * @param first The index of the first task of the range.
+ * @param last The index after the last task of the range.
+ * @param candidate The best task found so far, or 0 if none was found.
+ * @retval The best task of the range and the candidate.
+ */
+static uint16_t find_ready_task(uint16_t first, uint16_t last, uint16_t candidate) {
+    for (uint32_t word = first / 32; (word * 32) < last; ++word) {
+        uint32_t bits = ready_tasks[word];
+
+        if (word == (first / 32U))
+            bits &= ~0U << (first % 32);
+        while (bits) {
+            uint16_t task = (word * 32) + __builtin_ctz(bits);
+
+            if (task >= last)
+                return candidate;
+            if ((candidate == 0) || (user_tasks[task].priority > user_tasks[candidate].priority) ||
+                ((user_tasks[task].priority == user_tasks[candidate].priority) && user_tasks[task].slice_left &&
+                 !user_tasks[candidate].slice_left))
+                candidate = task;
+            bits &= bits - 1;
+        }
+    }
 
-    // update PSP and exit
-    __asm volatile("MSR PSP, R0");
-    __asm volatile("POP {LR}");
-    __asm volatile("BX LR");
+    return candidate;
 }
 
+/**
+ * @brief Update the value of `current_task` to the highest priority task in the
+ *        READY state. Tasks of equal priority are chosen in a round robin fashion,
+ *        starting from the task after the current one. If the state of all
+ *        user-defined tasks are set to BLOCKED, the idle task is chosen. Only the
+ *        READY tasks are visited, using the bitmap of READY tasks.
+ * @param None
+ * @retval None
+ */
+static void update_next_task(void) {
+    uint16_t next_task = 0; // the idle task is chosen if all tasks are blocked
+
+    // visit tasks in round robin order, ending with current_task; the idle task
+    // (0) is always ready and skipped
+    next_task = find_ready_task(current_task + 1, MAX_TASKS, next_task);
+    next_task = find_ready_task(1, current_task + 1, next_task);
+
+    current_task = next_task;
+}
+
+#endif // SCHED_EDF
+
 /**
  * @brief Update the the global tick count.
  * @param None
@@ -218,28 +750,96 @@ static void update_global_tick_count(void) {
 }
 
 /**
- * @brief Cycles through all tasks to mark any/all task states to READY, if possible.
+ * @brief Replenish the CPU budget of a task at the end of its budget period. Any
+ *        overrun is deducted from the new budget. Periods whose end was not seen,
+ *        e.g. because the simulator skipped idle ticks, are replenished as well.
+ * @param task The index of the task in `user_tasks`.
+ * @retval Non-zero if the task was THROTTLED and can run again.
+ */
+static uint8_t replenish_budget(uint16_t task) {
+    TCB_Type *tcb = &user_tasks[task];
+
+    do {
+        tcb->replenish_tick += tcb->budget_period;
+        tcb->budget_left += (int32_t)tcb->budget;
+    } while ((int32_t)(g_tick_count - tcb->replenish_tick) >= 0);
+    if (tcb->budget_left > (int32_t)tcb->budget)
+        tcb->budget_left = (int32_t)tcb->budget;
+
+    return (tcb->current_state == THROTTLED) && (tcb->budget_left > 0);
+}
+
+/**
+ * @brief Cycles through all tasks to mark any/all task states to READY, if possible,
+ *        including throttled tasks whose CPU budget is replenished.
  * @param None
- * @retval None
+ * @retval Non-zero if a task was made READY which preempts the running task.
  */
-static void unblock_tasks(void) {
+static uint8_t unblock_tasks(void) {
+    uint8_t preempt = 0;
+
     for (size_t i = 1; i < MAX_TASKS; ++i) {
-        if (user_tasks[i].current_state != READY)
-            if (user_tasks[i].block_count == g_tick_count)
-                user_tasks[i].current_state = READY;
+        uint8_t unblock = (user_tasks[i].current_state == BLOCKED) && (user_tasks[i].block_count == g_tick_count);
+
+        if (user_tasks[i].budget && ((int32_t)(g_tick_count - user_tasks[i].replenish_tick) >= 0) &&
+            replenish_budget(i))
+            unblock = 1;
+        if (unblock) {
+            set_task_state(i, READY);
+            TRACE_TASK_UNBLOCK(i);
+            if (preempts(i))
+                preempt = 1;
+        }
     }
+
+    return preempt;
 }
 
 /**
- * @brief Interrupt Service Routine for the SysTick exception which updates the
- *        global tick count, marks any/all task states to READY, if possible,
- *        and pends the PendSV exception to perform the context switching in a
- *        round robin fashion.
+ * @brief Charge the running task for its CPU time and throttle it if it has used up
+ *        its budget.
+ * @param None
+ * @retval Non-zero if the running task was throttled.
+ */
+static uint8_t enforce_budget(void) {
+    if (!user_tasks[current_task].budget || (user_tasks[current_task].current_state != READY))
+        return 0;
+
+    update_run_time();
+    if (user_tasks[current_task].budget_left > 0)
+        return 0;
+
+    set_task_state(current_task, THROTTLED);
+    TRACE_TASK_BLOCK(current_task, user_tasks[current_task].replenish_tick - g_tick_count);
+    return 1;
+}
+
+/**
+ * @brief Called by the port's tick interrupt, with interrupts disabled, to update
+ *        the global tick count, mark any/all task states to READY, if possible,
+ *        enforce the CPU budget and count down the time slice of the running
+ *        task. A context switch is pended only when a task that was made READY
+ *        preempts the running task, when the running task is throttled, or when
+ *        the time slice expires to schedule tasks of equal priority in a round
+ *        robin fashion.
  * @param None
  * @retval None
  */
-void SysTick_Handler(void) {
+void sched_tick(void) {
+    uint16_t *slice_left = &user_tasks[current_task].slice_left;
+    uint8_t preempt;
+
+    SCHED_HOOK_TICK_ENTER();
     update_global_tick_count();
-    unblock_tasks();
-    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    TRACE_TICK();
+    preempt = unblock_tasks();
+    if (enforce_budget())
+        preempt = 1;
+    else if (*slice_left && !--(*slice_left))
+        preempt = 1; // the time slice expired
+    if (preempt) {
+        LATENCY_PENDSV_PENDED(); // before pending, in case PendSV preempts the tick handler
+        port_pend_switch();
+    }
+    SCHED_HOOK_TICK_EXIT();
 }
@@ -0,0 +1,68 @@
+/**
+ ********************************************************
+ * @file    Src/semihosting.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          Arm semihosting requests, which are served by
+ *          a debugger or by QEMU. A request without a
+ *          debugger attached raises a HardFault, so these
+ *          must only be used by builds which select the
+ *          semihosting console.
+ ********************************************************
+ */
+
+#include "semihosting.h"
+#include <stdint.h>
+#include <string.h>
+
+#define SYS_WRITE0 0x04U                     // write a null terminated string to the console
+#define SYS_EXIT 0x18U                       // report an exception to the debugger
+#define ADP_STOPPED_APPLICATION_EXIT 0x20026 // reason passed with SYS_EXIT on normal termination
+
+/**
+ * @brief Issue a semihosting request to the debugger or emulator.
+ * @param operation The semihosting operation number.
+ * @param argument The operation specific argument.
+ * @retval The value returned by the debugger.
+ */
+static int semihosting_call(uint32_t operation, const void *argument) {
+    register uint32_t r0 __asm__("r0") = operation;
+    register const void *r1 __asm__("r1") = argument;
+
+    __asm volatile("BKPT 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return (int)r0;
+}
+
+/**
+ * @brief Write text to the semihosting console. The text is copied in chunks into
+ *        a null terminated buffer on the stack, so it must not contain null bytes.
+ * @param data The bytes to write.
+ * @param len The number of bytes to write.
+ * @retval The number of bytes written.
+ */
+int semihosting_write(const char *data, int len) {
+    char chunk[65];
+    int written = 0;
+
+    while (written < len) {
+        int count = ((len - written) < (int)(sizeof(chunk) - 1)) ? (len - written) : (int)(sizeof(chunk) - 1);
+        memcpy(chunk, &data[written], count);
+        chunk[count] = '\0';
+        semihosting_call(SYS_WRITE0, chunk);
+        written += count;
+    }
+
+    return len;
+}
+
+/**
+ * @brief End the emulation, or stop the debugger, reporting a normal exit.
+ * @param None
+ * @retval None
+ */
+void semihosting_exit(void) {
+    semihosting_call(SYS_EXIT, (const void *)ADP_STOPPED_APPLICATION_EXIT);
+    while (1)
+        ;
+}
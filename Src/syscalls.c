@@ -21,7 +21,10 @@
  */
 
 /* Includes */
+#include "scheduler.h"
+#include "semihosting.h"
 #include "stm32f4xx_conf.h"
+#include "uart.h"
 #include <errno.h>
 #include <signal.h>
 #include <stdio.h>
@@ -33,8 +36,6 @@
 
 /* Variables */
 extern int errno;
-extern int __io_getchar(void) __attribute__((weak));
-register char *stack_ptr asm("sp");
 
 char *__env[1] = {0};
 char **environ = __env;
@@ -60,32 +61,34 @@ void _exit(int status) {
     } /* Make sure we hang here */
 }
 
+#ifdef CONSOLE_SEMIHOSTING
+/* Console output goes to the debugger or emulator, e.g. QEMU, instead of USART2 */
+#define console_write semihosting_write
+#else
+#define console_write uart_write
+#endif
+
 __attribute__((weak)) int _read(int file, char *ptr, int len) {
     (void)file;
-    int DataIdx;
-
-    for (DataIdx = 0; DataIdx < len; DataIdx++) {
-        *ptr++ = __io_getchar();
-    }
-
-    return len;
+#ifdef CONSOLE_SEMIHOSTING
+    /* USART2 reception is not started, so stdin is at end of file */
+    (void)ptr;
+    (void)len;
+    return 0;
+#else
+    return uart_read(ptr, len);
+#endif
 }
 
 int __io_putchar(int ch) {
-    while (!USART_GetFlagStatus(USART2, USART_FLAG_TXE))
-        ;
-    USART_SendData(USART2, ch);
+    char c = (char)ch;
+    console_write(&c, 1);
     return ch;
 }
 
 __attribute__((weak)) int _write(int file, char *ptr, int len) {
     (void)file;
-    int DataIdx;
-
-    for (DataIdx = 0; DataIdx < len; DataIdx++) {
-        __io_putchar(*ptr++);
-    }
-    return len;
+    return console_write(ptr, len);
 }
 
 int _close(int file) {
@@ -163,18 +166,20 @@ int _execve(char *name, char **argv, char **env) {
 
 /**
  _sbrk
- Increase program data space. Malloc and related functions depend on this
+ Increase program data space. malloc() is served by Src/heap.c, so this only
+ hands out the RAM between the heap and the stacks. The limit is the bottom of
+ the scheduler stack, not the stack pointer, which is a task's PSP in a task.
 **/
 caddr_t _sbrk(int incr) {
-    extern char end asm("end");
+    extern char _heap_end[];
     static char *heap_end;
     char *prev_heap_end;
 
     if (heap_end == 0)
-        heap_end = &end;
+        heap_end = _heap_end;
 
     prev_heap_end = heap_end;
-    if (heap_end + incr > stack_ptr) {
+    if (heap_end + incr > (char *)(SCHED_STACK_START - SIZE_SCHEDULER_STACK)) {
         errno = ENOMEM;
         return (caddr_t)-1;
     }
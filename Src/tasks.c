@@ -4,12 +4,17 @@
  * @author  Jacob Zarnstorff
  * @date    09-January-2025
  * @brief   This file contains function
- *          definitions for task handlers
+ *          definitions for task handlers and the
+ *          table of periodic tasks
  ********************************************************
  */
 
+#include "tasks.h"
+#include "logging.h"
+#include "rma.h"
 #include "scheduler.h"
-#include <stdio.h>
+#include "task_table.h"
+#include <stdint.h>
 
 /**
  * @brief The idle task which is always marked as
@@ -19,53 +24,74 @@
  */
 void idle_task(void) {
     while (1)
-        ;
+        port_idle();
 }
 
 /**
- * @brief A task to be scheduled that prints a message to the UART
+ * @brief A task to be scheduled that logs a message to the UART
  * @param None
  * @retval None
  */
 void task_0_handler(void) {
+    uint32_t release = g_tick_count;
+
     while (1) {
-        printf("This is task 0\r\n");
-        task_delay(125);
+        LOG("This is task 0\r\n");
+        task_delay_until(&release, 125);
     }
 }
 
 /**
- * @brief A task to be scheduled that prints a message to the UART
+ * @brief A task to be scheduled that logs a message to the UART
  * @param None
  * @retval None
  */
 void task_1_handler(void) {
+    uint32_t release = g_tick_count;
+
     while (1) {
-        printf("This is task 1\r\n");
-        task_delay(250);
+        LOG("This is task 1\r\n");
+        task_delay_until(&release, 250);
     }
 }
 
 /**
- * @brief A task to be scheduled that prints a message to the UART
+ * @brief A task to be scheduled that logs a message to the UART
  * @param None
  * @retval None
  */
 void task_2_handler(void) {
+    uint32_t release = g_tick_count;
+
     while (1) {
-        printf("This is task 2\r\n");
-        task_delay(500);
+        LOG("This is task 2\r\n");
+        task_delay_until(&release, 500);
     }
 }
 
 /**
- * @brief A task to be scheduled that prints a message to the UART
+ * @brief A task to be scheduled that logs a message to the UART
  * @param None
  * @retval None
  */
 void task_3_handler(void) {
+    uint32_t release = g_tick_count;
+
     while (1) {
-        printf("This is task 3\r\n");
-        task_delay(1000);
+        LOG("This is task 3\r\n");
+        task_delay_until(&release, 1000);
     }
 }
+
+/**
+ * @brief Called by a periodic task which completed a job after its deadline.
+ * @param task The index of the late task in `user_tasks`.
+ * @param lateness The number of ticks the job was late.
+ * @retval None
+ */
+void deadline_miss_handler(uint16_t task, uint32_t lateness) {
+    LOG("Task %u missed its deadline by %u ticks\r\n", task, lateness);
+}
+
+PeriodicTask_Type periodic_tasks[] = {PERIODIC_TASK_TABLE(RMA_TASK)};
+const uint32_t periodic_task_count = sizeof(periodic_tasks) / sizeof(periodic_tasks[0]);
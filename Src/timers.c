@@ -0,0 +1,178 @@
+/**
+ ********************************************************
+ * @file    Src/timers.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          starting and stopping software timers and the
+ *          timer service task which executes the timer
+ *          callbacks on a single shared stack.
+ ********************************************************
+ */
+
+#include "timers.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static SoftTimer_Type *active_timers = NULL; // active timers sorted by expiry tick
+static uint16_t service_task = 0;            // index of the timer service task in `user_tasks`
+
+/**
+ * @brief Check if a tick count has been reached, taking wrap around of the
+ *        global tick count into account.
+ * @param tick The tick count to compare against the global tick count.
+ * @retval Non-zero if `tick` is now or in the past.
+ */
+static int tick_reached(uint32_t tick) {
+    return (int32_t)(tick - g_tick_count) <= 0;
+}
+
+/**
+ * @brief Insert a timer into the active list, keeping the list sorted by expiry
+ *        tick. Must be called with interrupts disabled.
+ * @param timer The timer to insert.
+ * @retval None
+ */
+static void insert_timer(SoftTimer_Type *timer) {
+    SoftTimer_Type **link = &active_timers;
+
+    while ((*link != NULL) && ((int32_t)((*link)->expiry - timer->expiry) <= 0))
+        link = &(*link)->next;
+
+    timer->next = *link;
+    *link = timer;
+    timer->active = 1;
+}
+
+/**
+ * @brief Remove a timer from the active list. Must be called with interrupts disabled.
+ * @param timer The timer to remove.
+ * @retval None
+ */
+static void remove_timer(SoftTimer_Type *timer) {
+    SoftTimer_Type **link = &active_timers;
+
+    while ((*link != NULL) && (*link != timer))
+        link = &(*link)->next;
+
+    if (*link != NULL)
+        *link = timer->next;
+
+    timer->next = NULL;
+    timer->active = 0;
+}
+
+/**
+ * @brief Wake the timer service task if it is sleeping, so it can recalculate
+ *        how long to sleep after the head of the active list changed. Must be
+ *        called with interrupts disabled.
+ * @param None
+ * @retval None
+ */
+static void notify_service_task(void) {
+    if (service_task && (user_tasks[service_task].current_state != READY) &&
+        (user_tasks[service_task].wait_object == &active_timers))
+        task_wake(service_task);
+}
+
+/**
+ * @brief Initialize a software timer. The timer is not started.
+ * @param timer The timer to initialize.
+ * @param callback The function executed by the timer service task when the timer expires.
+ * @param context User data available to the callback through `timer->context`.
+ * @param period The timer period in number of ticks; must be at least 1.
+ * @param mode `TIMER_ONE_SHOT` or `TIMER_AUTO_RELOAD`.
+ * @retval None
+ */
+void timer_init(
+    SoftTimer_Type *timer, void (*callback)(SoftTimer_Type *timer), void *context, uint32_t period, uint8_t mode
+) {
+    timer->callback = callback;
+    timer->context = context;
+    timer->period = period;
+    timer->expiry = 0;
+    timer->mode = mode;
+    timer->active = 0;
+    timer->next = NULL;
+}
+
+/**
+ * @brief Start, or restart, a software timer so it expires one period from now.
+ *        This function may be called from an interrupt service routine.
+ * @param timer The timer to start.
+ * @retval None
+ */
+void timer_start(SoftTimer_Type *timer) {
+    uint32_t primask = enter_critical();
+
+    if (timer->active)
+        remove_timer(timer);
+
+    timer->expiry = g_tick_count + timer->period;
+    insert_timer(timer);
+
+    if (active_timers == timer)
+        notify_service_task();
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief Stop a software timer. The callback is not executed for a stopped timer.
+ *        This function may be called from an interrupt service routine.
+ * @param timer The timer to stop.
+ * @retval None
+ */
+void timer_stop(SoftTimer_Type *timer) {
+    uint32_t primask = enter_critical();
+
+    if (timer->active)
+        remove_timer(timer);
+
+    exit_critical(primask);
+}
+
+/**
+ * @brief Check if a software timer is currently running.
+ * @param timer The timer to check.
+ * @retval Non-zero if the timer is active.
+ */
+uint8_t timer_is_active(SoftTimer_Type *timer) {
+    return timer->active;
+}
+
+/**
+ * @brief The timer service task executes the callbacks of all expired timers and
+ *        re-arms auto-reload timers. Between expiries it blocks until the head of
+ *        the active list is due, so it only runs when there is work to do.
+ *        Callbacks run in the context of this task and must not block for long.
+ * @param None
+ * @retval None
+ */
+void timer_service_task(void) {
+    service_task = current_task;
+
+    while (1) {
+        uint32_t primask = enter_critical();
+        SoftTimer_Type *timer = active_timers;
+
+        user_tasks[current_task].wait_object = NULL;
+
+        if ((timer != NULL) && tick_reached(timer->expiry)) {
+            remove_timer(timer);
+            if (timer->mode == TIMER_AUTO_RELOAD) {
+                // re-arm relative to the previous expiry so the period does not drift
+                timer->expiry += timer->period;
+                insert_timer(timer);
+            }
+            exit_critical(primask);
+
+            timer->callback(timer);
+            continue;
+        }
+
+        task_wait(&active_timers, 0, (timer != NULL) ? (timer->expiry - g_tick_count) : WAIT_FOREVER);
+        exit_critical(primask);
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ ********************************************************
+ * @file    Src/trace.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          recording scheduling events into a RAM ring
+ *          buffer, which keeps the most recent events, and
+ *          sending them to the host over the UART, either
+ *          on demand or continuously from the trace task.
+ ********************************************************
+ */
+
+#include "trace.h"
+
+#ifdef SCHED_TRACE
+
+#include "scheduler.h"
+#include "stm32f4xx.h"
+#include "uart.h"
+#include <stdint.h>
+
+static TraceRecord_Type trace_buffer[TRACE_BUFFER_SIZE];
+static volatile uint32_t trace_head = 0; // free running index of the next record to write
+static uint32_t trace_tail = 0;          // free running index of the next record to send
+static volatile uint8_t trace_enabled = 1;
+
+/**
+ * @brief Record a scheduling event, overwriting the oldest record when the buffer is
+ *        full. Safe to call from tasks and ISRs. Use the `TRACE_*()` hooks instead of
+ *        calling this function directly.
+ * @param event The type of the event.
+ * @param task The task the event refers to.
+ * @param arg Event specific argument.
+ * @retval None
+ */
+void trace_record(uint8_t event, uint16_t task, uint16_t arg) {
+    uint32_t primask;
+    TraceRecord_Type *record;
+
+    if (!trace_enabled)
+        return;
+
+    primask = enter_critical();
+    record = &trace_buffer[trace_head % TRACE_BUFFER_SIZE];
+    record->timestamp = read_timestamp();
+    record->event = event;
+    record->task = task;
+    record->arg = arg;
+    trace_head++;
+    exit_critical(primask);
+}
+
+/**
+ * @brief Resume recording scheduling events. Recording is enabled at reset.
+ * @param None
+ * @retval None
+ */
+void trace_start(void) {
+    trace_enabled = 1;
+}
+
+/**
+ * @brief Stop recording scheduling events, e.g. to freeze the events which led to
+ *        a fault or a missed deadline until they are dumped.
+ * @param None
+ * @retval None
+ */
+void trace_stop(void) {
+    trace_enabled = 0;
+}
+
+/**
+ * @brief Copy the records written since the previous call, oldest first. Records that
+ *        were overwritten before they could be read are counted as lost.
+ * @param records The array to copy the records to.
+ * @param max_records The size of `records`.
+ * @param p_lost Incremented by the number of lost records; may be NULL.
+ * @retval The number of records copied.
+ */
+uint32_t trace_read(TraceRecord_Type *records, uint32_t max_records, uint32_t *p_lost) {
+    uint32_t count = 0;
+    uint32_t primask = enter_critical();
+
+    if ((trace_head - trace_tail) > TRACE_BUFFER_SIZE) {
+        if (p_lost)
+            *p_lost += (trace_head - trace_tail) - TRACE_BUFFER_SIZE;
+        trace_tail = trace_head - TRACE_BUFFER_SIZE;
+    }
+
+    while ((count < max_records) && (trace_tail != trace_head))
+        records[count++] = trace_buffer[trace_tail++ % TRACE_BUFFER_SIZE];
+
+    exit_critical(primask);
+    return count;
+}
+
+/**
+ * @brief Send a frame of trace records to the host. A frame is made of the magic
+ *        bytes `TRACE_FRAME_MAGIC`, the 32-bit CPU frequency, the 16-bit number of
+ *        records, the 16-bit number of records lost before them and the records,
+ *        all in little endian byte order.
+ * @param records The records to send.
+ * @param count The number of records, at most `TRACE_FRAME_RECORDS`.
+ * @param lost The number of records lost since the previous frame.
+ * @retval None
+ */
+static void send_frame(const TraceRecord_Type *records, uint32_t count, uint32_t lost) {
+    uint8_t frame[12 + (9 * TRACE_FRAME_RECORDS)] = TRACE_FRAME_MAGIC;
+    uint32_t len = 4;
+
+    if (lost > 0xFFFF)
+        lost = 0xFFFF;
+
+    frame[len++] = (uint8_t)SystemCoreClock;
+    frame[len++] = (uint8_t)(SystemCoreClock >> 8);
+    frame[len++] = (uint8_t)(SystemCoreClock >> 16);
+    frame[len++] = (uint8_t)(SystemCoreClock >> 24);
+    frame[len++] = (uint8_t)count;
+    frame[len++] = (uint8_t)(count >> 8);
+    frame[len++] = (uint8_t)lost;
+    frame[len++] = (uint8_t)(lost >> 8);
+    for (uint32_t i = 0; i < count; ++i) {
+        frame[len++] = (uint8_t)records[i].timestamp;
+        frame[len++] = (uint8_t)(records[i].timestamp >> 8);
+        frame[len++] = (uint8_t)(records[i].timestamp >> 16);
+        frame[len++] = (uint8_t)(records[i].timestamp >> 24);
+        frame[len++] = records[i].event;
+        frame[len++] = (uint8_t)records[i].task;
+        frame[len++] = (uint8_t)(records[i].task >> 8);
+        frame[len++] = (uint8_t)records[i].arg;
+        frame[len++] = (uint8_t)(records[i].arg >> 8);
+    }
+
+    uart_write((const char *)frame, (int)len);
+}
+
+/**
+ * @brief Send all records written since the previous call to the host.
+ * @param None
+ * @retval None
+ */
+static void send_records(void) {
+    TraceRecord_Type records[TRACE_FRAME_RECORDS];
+    uint32_t lost = 0;
+    uint32_t count;
+
+    while ((count = trace_read(records, TRACE_FRAME_RECORDS, &lost)) != 0) {
+        send_frame(records, count, lost);
+        lost = 0;
+    }
+}
+
+/**
+ * @brief Send the contents of the trace buffer to the host on demand. Recording is
+ *        stopped while the buffer is sent, so the events sent are the ones that led
+ *        up to the call, and resumed afterwards if it was enabled. Must be called
+ *        from a task, as sending may block.
+ * @param None
+ * @retval None
+ */
+void trace_dump(void) {
+    uint8_t enabled = trace_enabled;
+
+    trace_stop();
+    send_records();
+    trace_enabled = enabled;
+}
+
+/**
+ * @brief The trace task streams new records to the host and then sleeps for
+ *        `TRACE_STREAM_PERIOD` ticks. It is optional; without it records are only
+ *        sent by `trace_dump()`. Logging and tracing share USART2, so it should
+ *        not be created together with the log task.
+ * @param None
+ * @retval None
+ */
+void trace_task(void) {
+    while (1) {
+        send_records();
+        task_delay(TRACE_STREAM_PERIOD);
+    }
+}
+
+#endif // SCHED_TRACE
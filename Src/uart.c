@@ -5,15 +5,45 @@
  * @date    09-January-2025
  * @brief   This file contains the function definition
  *          to enable TX pin on USART2 for the STM32F4xx
- *          microcontroller.
+ *          microcontroller, the double buffered DMA
+ *          transmit path used by `_write()` and the DMA
+ *          receive path with idle line detection.
  ********************************************************
  */
 
+#include "uart.h"
+#include "scheduler.h"
 #include "stm32f4xx_conf.h"
+#include "trace.h"
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+
+#define DMA_STREAM6_FLAGS                                                                                              \
+    (DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6)
+
+static uint8_t tx_buffers[2][UART_TX_BUFFER_SIZE]; // ping-pong buffers filled by tasks and drained by DMA
+static volatile uint8_t tx_fill = 0;               // index of the buffer tasks currently write into
+static volatile uint32_t tx_fill_len = 0;          // number of bytes written into the fill buffer
+static volatile uint8_t tx_dma_busy = 0;           // non-zero while DMA transmits the other buffer
+static volatile uint8_t tx_waiters = 0;            // number of tasks blocked on a full fill buffer
+
+#define DMA_STREAM5_FLAGS                                                                                              \
+    (DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5)
+
+static uint8_t rx_buffer[UART_RX_BUFFER_SIZE];         // circular buffer written by DMA
+static UartRxChunk_Type rx_chunks[UART_RX_QUEUE_SIZE]; // received chunks not yet taken by a task
+static volatile uint32_t rx_chunk_head = 0;            // free running index the ISR adds chunks at
+static volatile uint32_t rx_chunk_tail = 0;            // free running index tasks take chunks from
+static uint32_t rx_position = 0;                       // offset in `rx_buffer` up to which data was queued
+static volatile uint32_t rx_received = 0;              // free running count of received bytes up to `rx_position`
+static volatile uint32_t rx_unreleased = 0;            // bytes queued or held by a task, at most one buffer's worth
+static uint32_t rx_held = 0;                           // bytes of the chunk last returned by `uart_rx_receive()`
+static UartRxChunk_Type rx_partial = {0};              // remainder of a chunk partially consumed by `uart_read()`
+static volatile uint32_t rx_overruns = 0;              // number of times received data was lost
 
 /**
- * @brief Initialize and enable the transmit pin of USART2.
+ * @brief Initialize and enable the transmit pin of USART2 and DMA1 stream 6 to feed it.
  * @param baud_rate The desired baud rate USART2 should transmit data.
  * @retval None
  */
@@ -47,5 +77,352 @@ void init_usart2_tx(uint32_t baud_rate) {
 
     // intialize and enable USART2 for transmit only
     USART_Init(USART2, &USART_InitStruct);
+    USART_DMACmd(USART2, USART_DMAReq_Tx, ENABLE);
     USART_Cmd(USART2, ENABLE);
+
+    // enable clock for DMA1 on AHB1
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1, ENABLE);
+
+    // configure DMA1 stream 6 channel 4 (USART2_TX) for byte wide memory to
+    // peripheral transfers with an interrupt on transfer complete
+    DMA1_Stream6->CR = 0;
+    DMA1_Stream6->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_MINC | DMA_SxCR_DIR_0 | DMA_SxCR_TCIE;
+    DMA1_Stream6->PAR = (uint32_t)&USART2->DR;
+    DMA1->HIFCR = DMA_STREAM6_FLAGS;
+
+    NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+}
+
+/**
+ * @brief Initialize and enable the receive pin of USART2 with DMA1 stream 5 writing
+ *        received bytes into a circular buffer. Must be called after `init_usart2_tx()`.
+ *        Received data is handed to tasks when the line goes idle after a frame and
+ *        when DMA reaches the middle or end of the buffer, so there is no interrupt
+ *        per received byte.
+ * @param None
+ * @retval None
+ */
+void init_usart2_rx(void) {
+    GPIO_InitTypeDef GPIO_InitStruct = {
+        .GPIO_Pin = GPIO_Pin_3,
+        .GPIO_Mode = GPIO_Mode_AF,
+        .GPIO_Speed = GPIO_Speed_2MHz,
+        .GPIO_OType = GPIO_OType_PP,
+        .GPIO_PuPd = GPIO_PuPd_UP
+    };
+
+    // initialize GPIO PA3 and set alternate function as USART2_RX
+    GPIO_Init(GPIOA, &GPIO_InitStruct);
+    GPIO_PinAFConfig(GPIOA, GPIO_PinSource3, GPIO_AF_USART2);
+
+    // configure DMA1 stream 5 channel 4 (USART2_RX) for byte wide peripheral to
+    // memory transfers into the circular buffer with interrupts on half and full transfer
+    DMA1_Stream5->CR = 0;
+    DMA1_Stream5->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+    DMA1_Stream5->PAR = (uint32_t)&USART2->DR;
+    DMA1_Stream5->M0AR = (uint32_t)rx_buffer;
+    DMA1_Stream5->NDTR = UART_RX_BUFFER_SIZE;
+    DMA1->HIFCR = DMA_STREAM5_FLAGS;
+    DMA1_Stream5->CR |= DMA_SxCR_EN;
+
+    // enable the receiver of USART2, its DMA request and the idle line interrupt
+    USART2->CR1 |= USART_CR1_RE;
+    USART_DMACmd(USART2, USART_DMAReq_Rx, ENABLE);
+    USART_ITConfig(USART2, USART_IT_IDLE, ENABLE);
+
+    NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+    NVIC_EnableIRQ(USART2_IRQn);
+}
+
+/**
+ * @brief Start transmitting the fill buffer with DMA and make the other buffer the
+ *        new fill buffer. Must be called with interrupts disabled while DMA is idle
+ *        and the fill buffer holds data.
+ * @param None
+ * @retval None
+ */
+static void start_dma_transfer(void) {
+    DMA1->HIFCR = DMA_STREAM6_FLAGS;
+    DMA1_Stream6->M0AR = (uint32_t)tx_buffers[tx_fill];
+    DMA1_Stream6->NDTR = tx_fill_len;
+    DMA1_Stream6->CR |= DMA_SxCR_EN;
+
+    tx_fill ^= 1;
+    tx_fill_len = 0;
+    tx_dma_busy = 1;
+}
+
+/**
+ * @brief Handle the end of a DMA transfer: start transmitting the data written to the
+ *        fill buffer in the meantime, if any, and wake up the tasks blocked on a full
+ *        fill buffer. Must be called with interrupts disabled.
+ * @param None
+ * @retval None
+ */
+static void dma_transfer_complete(void) {
+    DMA1->HIFCR = DMA_HIFCR_CTCIF6;
+    tx_dma_busy = 0;
+
+    if (tx_fill_len)
+        start_dma_transfer();
+
+    if (tx_waiters) {
+        for (size_t i = 1; i < MAX_TASKS; ++i) {
+            if ((user_tasks[i].current_state != READY) && (user_tasks[i].wait_object == tx_buffers))
+                task_wake(i);
+        }
+        tx_waiters = 0;
+    }
+}
+
+/**
+ * @brief Copy data into the fill buffer and start a DMA transfer if DMA is idle, so
+ *        tasks fill one buffer while the other one is transmitted. When the fill buffer
+ *        is full, the calling task is blocked until the current transfer completes
+ *        instead of spinning. Callers that cannot block, e.g. fault handlers or code
+ *        that runs before the scheduler is launched, poll for the transfer to complete.
+ * @param data The bytes to transmit.
+ * @param len The number of bytes to transmit.
+ * @retval The number of bytes written.
+ */
+int uart_write(const char *data, int len) {
+    int written = 0;
+
+    while (written < len) {
+        uint32_t primask = enter_critical();
+        uint32_t space = UART_TX_BUFFER_SIZE - tx_fill_len;
+
+        if (space == 0) {
+            // the fill buffer is only full while DMA transmits the other buffer
+            if (task_can_block()) {
+                tx_waiters++;
+                task_wait(tx_buffers, 0, WAIT_FOREVER);
+            } else {
+                while (!(DMA1->HISR & DMA_HISR_TCIF6))
+                    ;
+                dma_transfer_complete();
+            }
+            exit_critical(primask);
+            continue; // the context switch takes place here; retry once woken up
+        }
+
+        uint32_t count = ((uint32_t)(len - written) < space) ? (uint32_t)(len - written) : space;
+        memcpy(&tx_buffers[tx_fill][tx_fill_len], &data[written], count);
+        tx_fill_len += count;
+        written += count;
+
+        if (!tx_dma_busy)
+            start_dma_transfer();
+
+        exit_critical(primask);
+    }
+
+    return written;
+}
+
+/**
+ * @brief Interrupt Service Routine for DMA1 stream 6 which is raised once per
+ *        transmitted buffer when the transfer to USART2 completes.
+ * @param None
+ * @retval None
+ */
+void DMA1_Stream6_IRQHandler(void) {
+    TRACE_ISR_ENTER();
+    if (DMA1->HISR & DMA_HISR_TCIF6) {
+        uint32_t primask = enter_critical();
+
+        dma_transfer_complete();
+        exit_critical(primask);
+    }
+    TRACE_ISR_EXIT();
+}
+
+/**
+ * @brief Queue a chunk of received data for the tasks. Must be called with
+ *        interrupts disabled.
+ * @param offset The offset of the chunk in the receive buffer.
+ * @param len The number of bytes in the chunk.
+ * @param end_of_frame Non-zero if the line went idle after the chunk.
+ * @retval None
+ */
+static void queue_rx_chunk(uint32_t offset, uint32_t len, uint8_t end_of_frame) {
+    uint32_t stream_offset = rx_received;
+
+    rx_received += len;
+    if (((rx_chunk_head - rx_chunk_tail) == UART_RX_QUEUE_SIZE) || ((rx_unreleased + len) > UART_RX_BUFFER_SIZE)) {
+        // DMA never stops, so the oldest unreleased data has been overwritten by now
+        rx_overruns++;
+        return;
+    }
+
+    rx_chunks[rx_chunk_head % UART_RX_QUEUE_SIZE] = (UartRxChunk_Type){
+        .data = &rx_buffer[offset], .len = (uint16_t)len, .end_of_frame = end_of_frame, .stream_offset = stream_offset
+    };
+    rx_chunk_head++;
+    rx_unreleased += len;
+}
+
+/**
+ * @brief Queue the data DMA has written to the receive buffer since the last call
+ *        and wake the tasks waiting for it. Data which wraps around the end of the
+ *        buffer is queued as two chunks. Must be called with interrupts disabled.
+ * @param end_of_frame Non-zero if called because the line went idle.
+ * @retval None
+ */
+static void receive_dma_data(uint8_t end_of_frame) {
+    uint32_t position = UART_RX_BUFFER_SIZE - DMA1_Stream5->NDTR;
+
+    if (position == rx_position)
+        return;
+
+    if (position < rx_position) {
+        queue_rx_chunk(rx_position, UART_RX_BUFFER_SIZE - rx_position, 0);
+        rx_position = 0;
+    }
+    if (position > rx_position)
+        queue_rx_chunk(rx_position, position - rx_position, end_of_frame);
+    rx_position = position % UART_RX_BUFFER_SIZE;
+
+    for (size_t i = 1; i < MAX_TASKS; ++i) {
+        if ((user_tasks[i].current_state != READY) && (user_tasks[i].wait_object == rx_chunks))
+            task_wake(i);
+    }
+}
+
+/**
+ * @brief Wait for the next chunk of received data. The chunk points directly into
+ *        the DMA receive buffer, so no data is copied. It is held until the next
+ *        call to this function, which releases it. The receive DMA is circular and
+ *        never stops, so if a chunk is held while a whole buffer's worth of data
+ *        arrives, DMA overwrites it; the data that arrives while too much is
+ *        unreleased is dropped and counted as an overrun. Check the chunk with
+ *        `uart_rx_chunk_intact()` after using it. A frame ends with the chunk
+ *        that has `end_of_frame` set.
+ * @param chunk Pointer to where the received chunk is stored.
+ * @param tick_count Timeout in number of ticks, 0 to poll, or `WAIT_FOREVER`.
+ * @retval Non-zero if a chunk was received, 0 on timeout.
+ */
+uint8_t uart_rx_receive(UartRxChunk_Type *chunk, uint32_t tick_count) {
+    uint32_t primask = enter_critical();
+
+    rx_unreleased -= rx_held;
+    rx_held = 0;
+
+    while (rx_chunk_head == rx_chunk_tail) {
+        if ((tick_count == 0) || !task_can_block()) {
+            exit_critical(primask);
+            return 0;
+        }
+
+        task_wait(rx_chunks, 0, tick_count);
+        exit_critical(primask);
+
+        // the context switch to another task takes place here
+
+        primask = enter_critical();
+        if (user_tasks[current_task].wait_object != NULL) {
+            user_tasks[current_task].wait_object = NULL; // timed out
+            tick_count = 0;
+        }
+    }
+
+    *chunk = rx_chunks[rx_chunk_tail % UART_RX_QUEUE_SIZE];
+    rx_chunk_tail++;
+    rx_held = chunk->len;
+
+    exit_critical(primask);
+    return 1;
+}
+
+/**
+ * @brief Copy received data, blocking until at least one byte is available. This is
+ *        the copying counterpart of `uart_rx_receive()` used by `_read()`; a task
+ *        should use only one of the two.
+ * @param data Pointer to where the received bytes are copied.
+ * @param len The maximum number of bytes to copy.
+ * @retval The number of bytes copied.
+ */
+int uart_read(char *data, int len) {
+    int copied = 0;
+
+    if ((len > 0) && (rx_partial.len == 0) && !uart_rx_receive(&rx_partial, WAIT_FOREVER))
+        return 0;
+
+    UartRxChunk_Type copied_from = rx_partial;
+
+    while ((copied < len) && (rx_partial.len > 0)) {
+        data[copied++] = (char)*rx_partial.data++;
+        rx_partial.len--;
+        rx_partial.stream_offset++;
+    }
+    if (copied && !uart_rx_chunk_intact(&copied_from))
+        rx_overruns++; // the bytes just copied may have been overwritten
+
+    return copied;
+}
+
+/**
+ * @brief Check if DMA has overwritten any byte of a chunk returned by
+ *        `uart_rx_receive()` since it was received. Call it after using the
+ *        chunk's data, so a chunk that was overwritten in the meantime is
+ *        detected.
+ * @param chunk The received chunk.
+ * @retval Non-zero if the data of the chunk is still the received data.
+ */
+uint8_t uart_rx_chunk_intact(const UartRxChunk_Type *chunk) {
+    uint32_t primask = enter_critical();
+    uint32_t position = UART_RX_BUFFER_SIZE - DMA1_Stream5->NDTR;
+    uint32_t written = rx_received + ((position + UART_RX_BUFFER_SIZE - rx_position) % UART_RX_BUFFER_SIZE);
+
+    exit_critical(primask);
+    return (written - chunk->stream_offset) <= UART_RX_BUFFER_SIZE;
+}
+
+/**
+ * @brief Get the number of times received data was lost because the chunk queue was
+ *        full or the receive buffer was not released fast enough, in which case DMA
+ *        has overwritten unreleased data.
+ * @param None
+ * @retval The number of receive overruns.
+ */
+uint32_t uart_rx_overruns(void) {
+    return rx_overruns;
+}
+
+/**
+ * @brief Interrupt Service Routine for DMA1 stream 5 which is raised when DMA reaches
+ *        the middle and the end of the circular receive buffer.
+ * @param None
+ * @retval None
+ */
+void DMA1_Stream5_IRQHandler(void) {
+    uint32_t primask;
+
+    TRACE_ISR_ENTER();
+    primask = enter_critical();
+    DMA1->HIFCR = DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTCIF5;
+    receive_dma_data(0);
+    exit_critical(primask);
+    TRACE_ISR_EXIT();
+}
+
+/**
+ * @brief Interrupt Service Routine for USART2 which is raised when the receive line
+ *        goes idle for one frame time, marking the end of a received frame.
+ * @param None
+ * @retval None
+ */
+void USART2_IRQHandler(void) {
+    uint32_t primask;
+
+    if (USART_GetITStatus(USART2, USART_IT_IDLE) == RESET)
+        return;
+
+    TRACE_ISR_ENTER();
+    // the idle flag is cleared by reading the status register followed by the data register
+    (void)USART_ReceiveData(USART2);
+    primask = enter_critical();
+    receive_dma_data(1);
+    exit_critical(primask);
+    TRACE_ISR_EXIT();
 }
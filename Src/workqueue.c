@@ -0,0 +1,117 @@
+/**
+ ********************************************************
+ * @file    Src/workqueue.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains function definitions for
+ *          posting work items from interrupt service
+ *          routines and the worker task that drains the
+ *          deferred work queue.
+ ********************************************************
+ */
+
+#include "workqueue.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static WorkItem_Type *work_items[WORKQUEUE_SIZE]; // ring buffer of pending work items
+static uint32_t head = 0;                         // index the next work item is posted to
+static uint32_t tail = 0;                         // index the next work item is taken from
+static WorkQueueStats_Type stats = {0};
+
+/**
+ * @brief Initialize a work item.
+ * @param work The work item to initialize.
+ * @param handler The function executed by the worker task when the work item runs.
+ * @param context User data available to the handler through `work->context`.
+ * @retval None
+ */
+void work_init(WorkItem_Type *work, void (*handler)(WorkItem_Type *work), void *context) {
+    work->handler = handler;
+    work->context = context;
+    work->pending = 0;
+    work->post_cycles = 0;
+}
+
+/**
+ * @brief Post a work item to the deferred work queue in constant time and wake the
+ *        worker task. If the work item is already pending the post is coalesced into
+ *        it. This function is intended to be called from interrupt service routines,
+ *        but may be called from tasks as well.
+ * @param work The work item to post.
+ * @retval `WORK_QUEUED`, `WORK_COALESCED` or `WORK_QUEUE_FULL`.
+ */
+uint8_t work_post(WorkItem_Type *work) {
+    uint32_t primask = enter_critical();
+    uint8_t result = WORK_QUEUED;
+
+    if (work->pending) {
+        stats.coalesced++;
+        result = WORK_COALESCED;
+    } else if (stats.depth == WORKQUEUE_SIZE) {
+        stats.dropped++;
+        result = WORK_QUEUE_FULL;
+    } else {
+        work->pending = 1;
+        work->post_cycles = read_timestamp();
+        work_items[head] = work;
+        head = (head + 1) % WORKQUEUE_SIZE;
+
+        stats.posted++;
+        if (++stats.depth > stats.max_depth)
+            stats.max_depth = stats.depth;
+
+        for (size_t i = 1; i < MAX_TASKS; ++i) {
+            if ((user_tasks[i].current_state != READY) && (user_tasks[i].wait_object == work_items))
+                task_wake(i);
+        }
+    }
+
+    exit_critical(primask);
+    return result;
+}
+
+/**
+ * @brief Get a snapshot of the deferred work queue statistics.
+ * @param p_stats Pointer to where the statistics are copied.
+ * @retval None
+ */
+void workqueue_get_stats(WorkQueueStats_Type *p_stats) {
+    uint32_t primask = enter_critical();
+    *p_stats = stats;
+    exit_critical(primask);
+}
+
+/**
+ * @brief The worker task executes pending work items in the order they were
+ *        posted and blocks while the queue is empty. A work item is no longer
+ *        pending once its handler starts, so it can be posted again from within
+ *        the handler or by an ISR while the handler runs.
+ * @param None
+ * @retval None
+ */
+void workqueue_task(void) {
+    while (1) {
+        uint32_t primask = enter_critical();
+
+        if (stats.depth == 0) {
+            task_wait(work_items, 0, WAIT_FOREVER);
+            exit_critical(primask);
+            continue;
+        }
+
+        WorkItem_Type *work = work_items[tail];
+        tail = (tail + 1) % WORKQUEUE_SIZE;
+        stats.depth--;
+
+        work->pending = 0;
+        uint32_t latency = read_timestamp() - work->post_cycles;
+        if (latency > stats.max_latency_cycles)
+            stats.max_latency_cycles = latency;
+
+        exit_critical(primask);
+
+        work->handler(work);
+    }
+}
@@ -1,6 +1,13 @@
+#include "cpu_stats.h"
+#include "logging.h"
+#include "rma.h"
 #include "scb.h"
 #include "scheduler.h"
+#include "tasks.h"
+#include "timers.h"
 #include "uart.h"
+#include "workqueue.h"
+#include <stdio.h>
 
 #if !defined(__SOFT_FP__) && defined(__ARM_FP)
 #warning "FPU is not initialized, but the project is compiling for an FPU. Please initialize the FPU before use."
@@ -8,9 +15,21 @@
 
 int main(void) {
     enable_processor_faults();
+    enable_cycle_counter();
+#ifndef CONSOLE_SEMIHOSTING
     init_usart2_tx(115200);
+    init_usart2_rx();
+#endif
 
     init_scheduler_stack(SCHED_STACK_START);
-    init_tasks_stack();
+    task_set_deadline_callback(deadline_miss_handler);
+    if (!rma_create_tasks(periodic_tasks, periodic_task_count))
+        printf("Periodic tasks rejected: deadlines can be missed\r\n");
+    task_create(timer_service_task, DEFAULT_TASK_PRIORITY);
+    task_create(workqueue_task, WORKQUEUE_TASK_PRIORITY);
+#ifndef CONSOLE_SEMIHOSTING
+    task_create(log_task, LOG_TASK_PRIORITY);
+#endif
+    cpu_stats_init();
     launch_scheduler(TICK_HZ_MS);
 }
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Decode the binary log frames sent by the firmware's LOG() macro.
+
+The firmware only sends the offset of each format string in the ELF's
+`.log_strings` section, a cycle count timestamp and the raw 32-bit
+arguments. This script reads the format strings back from the ELF file and
+expands every frame read from a capture file or serial device.
+
+    stty -F /dev/ttyACM0 115200 raw
+    ./tools/log_decode.py build/task_sheduler.elf /dev/ttyACM0
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+ISR_SOURCE = 0xFF
+DROPPED_FORMAT = 0xFFFF
+MAX_ARGS = 8
+
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcp%])")
+
+
+def read_log_strings(elf_path):
+    """Return the contents of the `.log_strings` section of a 32-bit little endian ELF file."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        sys.exit(f"{elf_path}: not a 32-bit little endian ELF file")
+
+    e_shoff, = struct.unpack_from("<I", elf, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+
+    def section(index):
+        return struct.unpack_from("<IIIIIIIIII", elf, e_shoff + index * e_shentsize)
+
+    shstrtab = section(e_shstrndx)
+    for i in range(e_shnum):
+        sh_name, _, _, _, sh_offset, sh_size, *_ = section(i)
+        name_start = shstrtab[4] + sh_name
+        name = elf[name_start:elf.index(b"\0", name_start)].decode()
+        if name == ".log_strings":
+            return elf[sh_offset:sh_offset + sh_size]
+
+    sys.exit(f"{elf_path}: no .log_strings section")
+
+
+def format_record(fmt, args):
+    """Expand a C format string with the raw 32-bit arguments of a record."""
+    args = iter(args)
+
+    def convert(match):
+        flags, _, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = next(args, 0)
+        if conversion in "di":
+            value = struct.unpack("<i", struct.pack("<I", value))[0]
+            conversion = "d"
+        elif conversion == "u":
+            conversion = "d"
+        elif conversion == "c":
+            value = chr(value & 0xFF)
+        elif conversion == "p":
+            return f"0x{value:08x}"
+        return f"%{flags}{conversion}" % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def frames(stream):
+    """Yield (source, format id, timestamp, args) for every frame in a byte stream."""
+    while True:
+        sync = stream.read(1)
+        if not sync:
+            return
+        if sync[0] != FRAME_SYNC:
+            continue
+
+        header = stream.read(8)
+        if len(header) < 8:
+            return
+        source, nargs, fmt_id, timestamp = struct.unpack("<BBHI", header)
+        if nargs > MAX_ARGS:
+            continue  # not a frame; resynchronize on the next sync byte
+
+        payload = stream.read(4 * nargs)
+        if len(payload) < 4 * nargs:
+            return
+        yield source, fmt_id, timestamp, struct.unpack(f"<{nargs}I", payload)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="the firmware ELF file the log was produced by")
+    parser.add_argument("input", nargs="?", help="capture file or serial device (default: stdin)")
+    parser.add_argument("--cpu-hz", type=float, default=16e6, help="cycle counter frequency (default: 16 MHz HSI)")
+    args = parser.parse_args()
+
+    strings = read_log_strings(args.elf)
+    stream = open(args.input, "rb", buffering=0) if args.input else sys.stdin.buffer
+
+    for source, fmt_id, timestamp, values in frames(stream):
+        origin = "isr" if source == ISR_SOURCE else f"task {source}"
+        if fmt_id == DROPPED_FORMAT:
+            text = f"<{values[0] if values else 0} log records dropped>"
+        elif fmt_id < len(strings):
+            fmt = strings[fmt_id:strings.index(b"\0", fmt_id)].decode(errors="replace")
+            text = format_record(fmt, values).rstrip("\r\n")
+        else:
+            text = f"<unknown format id {fmt_id:#06x}>"
+        print(f"[{timestamp / args.cpu_hz:12.6f}] {origin:>7}: {text}", flush=True)
+
+
+if __name__ == "__main__":
+    main()
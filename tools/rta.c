@@ -0,0 +1,55 @@
+/**
+ ********************************************************
+ * @file    tools/rta.c
+ * @author  Jacob Zarnstorff
+ * @date    19-October-2026
+ * @brief   This file contains a host tool which runs the
+ *          response time analysis of the firmware on the
+ *          periodic task table in `Inc/task_table.h` and
+ *          reports the priority, response time and slack
+ *          of every task. It exits with a non-zero status
+ *          if a task can miss its deadline.
+ ********************************************************
+ */
+
+#include "rma.h"
+#include "task_table.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief An entry of the task table without the handler, which is not linked.
+ */
+#define TOOL_TASK(handler, task_period, task_deadline, task_wcet)                                                      \
+    {.name = #handler, .period = task_period, .deadline = task_deadline, .wcet = task_wcet},
+
+static PeriodicTask_Type tasks[] = {PERIODIC_TASK_TABLE(TOOL_TASK)};
+
+int main(void) {
+    uint32_t count = sizeof(tasks) / sizeof(tasks[0]);
+    uint8_t schedulable = rma_analyze(tasks, count);
+    double utilization = 0.0;
+
+    printf("%-24s %8s %8s %8s %4s %11s %11s\n", "task", "period", "deadline", "wcet_us", "prio", "response_us",
+           "slack_us");
+    for (uint32_t i = 0; i < count; ++i) {
+        const PeriodicTask_Type *task = &tasks[i];
+        uint32_t deadline = (task->deadline && (task->deadline < task->period)) ? task->deadline : task->period;
+
+        if (task->period)
+            utilization += (double)task->wcet / ((double)task->period * RMA_TICK_US);
+        if (task->response_time == RMA_UNSCHEDULABLE)
+            printf("%-24s %8u %8u %8u %4u %11s %11s\n", task->name, task->period, deadline, task->wcet, task->priority,
+                   "miss", "-");
+        else
+            printf("%-24s %8u %8u %8u %4u %11u %11lld\n", task->name, task->period, deadline, task->wcet,
+                   task->priority, task->response_time,
+                   ((long long)deadline * RMA_TICK_US) - task->response_time);
+    }
+
+    printf("\nutilization %.2f%%, Liu and Layland bound %.2f%%, tick overhead %u us\n", 100.0 * utilization,
+           100.0 * count * (pow(2.0, 1.0 / count) - 1.0), RMA_TICK_OVERHEAD_US);
+    printf("%s\n", schedulable ? "schedulable" : "NOT schedulable: a task can miss its deadline");
+    return schedulable ? 0 : 1;
+}
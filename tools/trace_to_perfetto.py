@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Convert the scheduler trace frames sent by the firmware to Chrome trace JSON.
+
+The firmware is built with `make TRACE=1` and sends its trace buffer over
+USART2 when `trace_dump()` is called, or continuously from `trace_task()`.
+The JSON written by this script can be opened with https://ui.perfetto.dev
+or chrome://tracing to view the task timeline.
+
+    stty -F /dev/ttyACM0 115200 raw
+    cat /dev/ttyACM0 > trace.bin
+    ./tools/trace_to_perfetto.py trace.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+FRAME_MAGIC = b"TRC2"
+RECORD = struct.Struct("<IBHH")
+
+SWITCH_OUT, SWITCH_IN, BLOCK, UNBLOCK, TICK, ISR_ENTER, ISR_EXIT = range(1, 8)
+TASK_STATES = {1: "ready", 2: "blocked", 3: "waiting"}
+
+PID = 1
+ISR_TID = 0x10000  # above every 16-bit task index
+
+
+def frames(data):
+    """Yield (cpu hz, lost, records) for every frame in a byte string."""
+    offset = data.find(FRAME_MAGIC)
+    while offset >= 0 and offset + 12 <= len(data):
+        cpu_hz, count, lost = struct.unpack_from("<IHH", data, offset + 4)
+        end = offset + 12 + count * RECORD.size
+        if end > len(data):
+            return
+        records = [RECORD.unpack_from(data, offset + 12 + i * RECORD.size) for i in range(count)]
+        yield cpu_hz, lost, records
+        offset = data.find(FRAME_MAGIC, end)
+
+
+def convert(data, names, cpu_hz_override):
+    """Return the list of Chrome trace events for the trace frames in `data`."""
+    events = []
+    tasks = set()
+    running = {}  # task -> start time in microseconds of its current slice
+    isr_open = []  # stack of (exception number, start time) of nested ISRs
+    cycles = None  # unwrapped 64-bit time of the previous record
+    previous = None
+
+    def task_name(task):
+        return names.get(task, "idle" if task == 0 else f"task {task}")
+
+    for cpu_hz, lost, records in frames(data):
+        hz = cpu_hz_override or cpu_hz
+        if lost:
+            if cycles is not None:
+                events.append({"name": f"{lost} records lost", "ph": "i", "s": "g", "pid": PID, "tid": 0,
+                               "ts": cycles * 1e6 / hz})
+            running.clear()
+            isr_open.clear()
+
+        for timestamp, event, task, arg in records:
+            if cycles is None:
+                cycles = 0
+            else:
+                cycles += (timestamp - previous) & 0xFFFFFFFF
+            previous = timestamp
+            ts = cycles * 1e6 / hz
+            tasks.add(task)
+
+            if event == SWITCH_IN:
+                running[task] = ts
+            elif event == SWITCH_OUT:
+                if task in running:
+                    start = running.pop(task)
+                    events.append({"name": task_name(task), "ph": "X", "pid": PID, "tid": task, "ts": start,
+                                   "dur": ts - start, "args": {"state after": TASK_STATES.get(arg, arg)}})
+            elif event == BLOCK:
+                events.append({"name": "block", "ph": "i", "s": "t", "pid": PID, "tid": task, "ts": ts,
+                               "args": {"ticks": arg if arg else "forever"}})
+            elif event == UNBLOCK:
+                events.append({"name": "unblock", "ph": "i", "s": "t", "pid": PID, "tid": task, "ts": ts})
+            elif event == TICK:
+                events.append({"name": "tick", "ph": "i", "s": "p", "pid": PID, "tid": task, "ts": ts,
+                               "args": {"tick": arg}})
+            elif event == ISR_ENTER:
+                isr_open.append((arg, ts))
+            elif event == ISR_EXIT:
+                if isr_open:
+                    exception, start = isr_open.pop()
+                    events.append({"name": f"IRQ {exception - 16}", "ph": "X", "pid": PID, "tid": ISR_TID,
+                                   "ts": start, "dur": ts - start})
+
+    events.append({"name": "process_name", "ph": "M", "pid": PID, "args": {"name": "CPU"}})
+    events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": ISR_TID, "args": {"name": "ISRs"}})
+    for task in sorted(tasks):
+        events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": task, "args": {"name": task_name(task)}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="capture file (default: stdin)")
+    parser.add_argument("-o", "--output", help="JSON output file (default: stdout)")
+    parser.add_argument("--cpu-hz", type=float, help="timestamp frequency (default: as reported by the firmware)")
+    parser.add_argument("--name", action="append", default=[], metavar="TASK=NAME", help="name a task id")
+    args = parser.parse_args()
+
+    names = {}
+    for name in args.name:
+        task, _, label = name.partition("=")
+        names[int(task)] = label
+
+    data = open(args.input, "rb").read() if args.input else sys.stdin.buffer.read()
+    events = convert(data, names, args.cpu_hz)
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, output)
+
+
+if __name__ == "__main__":
+    main()